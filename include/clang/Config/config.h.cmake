@@ -81,6 +81,9 @@
 /* Enable UPC backtrace */
 #cmakedefine LIBUPC_ENABLE_BACKTRACE 1
 
+/* UPC runtime bitcode libraries for LTO */
+#cmakedefine LIBUPC_ENABLE_LTO_LIB 1
+
 /* Portals4 support */
 #cmakedefine LIBUPC_PORTALS4 "${LIBUPC_PORTALS4}"
 
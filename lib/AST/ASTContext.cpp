@@ -1991,7 +1991,9 @@ TypeInfo ASTContext::getTypeInfoImpl(const Type *T) const {
   case Type::Pointer: {
     if (cast<PointerType>(T)->getPointeeType().getQualifiers().hasShared()) {
       Width = (LangOpts.UPCPhaseBits + LangOpts.UPCThreadBits + LangOpts.UPCAddrBits);
-      if (LangOpts.UPCPtsRep)
+      if (LangOpts.UPCPtsRep && Width > 64)
+        Align = getTypeAlign(UnsignedInt128Ty); // Wide packed PTS
+      else if (LangOpts.UPCPtsRep)
         Align = Target->getTypeAlign(Target->getInt64Type()); // Packed PTS
       else
         Align = Target->getTypeAlign(Target->getIntPtrType()); // Struct PTS
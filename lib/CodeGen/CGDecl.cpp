@@ -335,6 +335,12 @@ static bool hasNontrivialDestruction(QualType T) {
 llvm::GlobalVariable *
 CodeGenFunction::AddInitializerToStaticVarDecl(const VarDecl &D,
                                                llvm::GlobalVariable *GV) {
+  // Each thread copies its part of a shared array from an init image.
+  if (D.getType()->isArrayType() && D.getType().getQualifiers().hasShared()) {
+    CGM.EmitUPCSharedArrayInitFunc(&D, GV);
+    return GV;
+  }
+
   ConstantEmitter emitter(*this);
   llvm::Constant *Init = 0;
 
@@ -12,8 +12,10 @@
 //===----------------------------------------------------------------------===//
 
 #include "CodeGenModule.h"
+#include "ConstantEmitter.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Constants.h"
+#include "llvm/IR/IRBuilder.h"
 
 using namespace clang;
 using namespace CodeGen;
@@ -25,16 +27,15 @@ llvm::Constant *CodeGenModule::MaybeEmitUPCSharedArrayInits(const VarDecl *VD) {
   QualType CurTy = SrcTy.getCanonicalType();
   Qualifiers Quals = SrcTy.getQualifiers();
 
+  // The initial values are copied in by each thread at startup
+  // (see EmitUPCSharedArrayInitFunc); the array itself is
+  // zero-initialized.
   const Expr *InitExpr = VD->getAnyInitializer();
-  if(InitExpr) {
-    ErrorUnsupported(VD, "initialization of shared array");
-    return 0;
-  }
 
   // indefinite block size: emit as normal array
   if (Quals.hasLayoutQualifier() &&
       Quals.getLayoutQualifier() == 0)
-    return 0;
+    return InitExpr ? EmitNullConstant(SrcTy) : 0;
 
   ASTContext &Ctx = getContext();
 
@@ -75,3 +76,181 @@ llvm::Constant *CodeGenModule::MaybeEmitUPCSharedArrayInits(const VarDecl *VD) {
 
   return EmitNullConstant(LocalArrayType);
 }
+
+namespace {
+// Flattens the initializer of a shared array into a list of element
+// values, in array index order.
+struct UPCSharedArrayInitFlattener {
+  CodeGenModule &CGM;
+  QualType EltTy;
+  SmallVector<llvm::Constant *, 16> Elts;
+
+  UPCSharedArrayInitFlattener(CodeGenModule &CGM, QualType EltTy)
+    : CGM(CGM), EltTy(EltTy) {}
+
+  // Return the number of elements of type EltTy in an object of type Ty,
+  // or 0 if it depends on THREADS, and THREADS is not known.
+  uint64_t getNumElements(QualType Ty) {
+    uint64_t N = 1;
+    while (const ArrayType *AT = Ty->getAsArrayTypeUnsafe()) {
+      if (const ConstantArrayType *CAT = dyn_cast<ConstantArrayType>(AT))
+        N *= CAT->getSize().getZExtValue();
+      else if (const UPCThreadArrayType *TAT =
+                 dyn_cast<UPCThreadArrayType>(AT)) {
+        N *= TAT->getSize().getZExtValue();
+        if (TAT->getThread()) {
+          if (!CGM.getLangOpts().UPCThreads)
+            return 0;
+          N *= CGM.getLangOpts().UPCThreads;
+        }
+      } else
+        return 0;
+      Ty = AT->getElementType();
+    }
+    return N;
+  }
+
+  void set(uint64_t Index, llvm::Constant *C) {
+    if (Index >= Elts.size())
+      Elts.resize(Index + 1, nullptr);
+    Elts[Index] = C;
+  }
+
+  // Add the values given by initializer E for the object of type Ty
+  // that starts at element Index.  Return false if the initializer
+  // cannot be evaluated at compile time.
+  bool add(const Expr *E, QualType Ty, uint64_t Index) {
+    if (isa<ImplicitValueInitExpr>(E))
+      return true;
+    if (const ArrayType *AT = Ty->getAsArrayTypeUnsafe()) {
+      QualType SubTy = AT->getElementType();
+      uint64_t Stride = getNumElements(SubTy);
+      if (!Stride)
+        return false;
+      if (const StringLiteral *SL =
+            dyn_cast<StringLiteral>(E->IgnoreParens())) {
+        llvm::Type *CharTy = CGM.getTypes().ConvertTypeForMem(SubTy);
+        for (unsigned I = 0, N = SL->getLength(); I != N; ++I)
+          if (uint32_t C = SL->getCodeUnit(I))
+            set(Index + I, llvm::ConstantInt::get(CharTy, C));
+        return true;
+      }
+      const InitListExpr *ILE = dyn_cast<InitListExpr>(E);
+      if (!ILE)
+        return false;
+      for (unsigned I = 0, N = ILE->getNumInits(); I != N; ++I)
+        if (!add(ILE->getInit(I), SubTy, Index + I * Stride))
+          return false;
+      // Remaining elements are zero; they need no initialization.
+      if (const Expr *Filler = ILE->getArrayFiller())
+        if (!isa<ImplicitValueInitExpr>(Filler)) {
+          llvm::Constant *C =
+            ConstantEmitter(CGM).tryEmitAbstract(Filler, SubTy);
+          if (!C || !C->isNullValue())
+            return false;
+        }
+      return true;
+    }
+    llvm::Constant *C =
+      ConstantEmitter(CGM).tryEmitAbstract(E, Ty.getUnqualifiedType());
+    if (!C)
+      return false;
+    if (!C->isNullValue())
+      set(Index, C);
+    return true;
+  }
+};
+}
+
+// Emit an initialization routine for a shared array that has an initializer.
+// The initial values of the array are emitted as a constant image, and each
+// thread copies the elements that have affinity to it from this image into
+// its part of the array.  This is done at startup, by the UPC initialization
+// routines, and involves no communication between threads.
+void CodeGenModule::EmitUPCSharedArrayInitFunc(const VarDecl *VD,
+                                               llvm::GlobalVariable *GV) {
+  const Expr *InitExpr = VD->getAnyInitializer();
+  if (!InitExpr)
+    return;
+
+  ASTContext &Ctx = getContext();
+  QualType SrcTy = VD->getType();
+  Qualifiers Quals = SrcTy.getQualifiers();
+
+  // Find the element type, and the number of elements per THREADS
+  // if the outermost dimension is a multiple of THREADS.
+  QualType EltTy = SrcTy.getCanonicalType();
+  uint64_t ThreadsScale = 0;
+  if (const UPCThreadArrayType *TAT =
+        dyn_cast<UPCThreadArrayType>(EltTy.getTypePtr()))
+    if (TAT->getThread())
+      ThreadsScale = TAT->getSize().getZExtValue();
+  while (const ArrayType *AT = EltTy->getAsArrayTypeUnsafe())
+    EltTy = AT->getElementType();
+  EltTy = EltTy.getUnqualifiedType();
+
+  UPCSharedArrayInitFlattener Flattener(*this, EltTy);
+  const ArrayType *AT = SrcTy->getAsArrayTypeUnsafe();
+  if (ThreadsScale) {
+    uint64_t Stride = Flattener.getNumElements(AT->getElementType());
+    ThreadsScale *= Stride;
+  }
+  if (!Flattener.add(InitExpr, SrcTy, 0)) {
+    ErrorUnsupported(VD, "initialization of shared array");
+    return;
+  }
+  SmallVectorImpl<llvm::Constant *> &Elts = Flattener.Elts;
+  if (Elts.empty())
+    return;
+
+  // Create the init image.
+  llvm::Constant *Zero = EmitNullConstant(EltTy);
+  bool SameType = true;
+  for (llvm::Constant *&C : Elts) {
+    if (!C)
+      C = Zero;
+    SameType &= C->getType() == Zero->getType();
+  }
+  llvm::Constant *Image;
+  if (SameType)
+    Image = llvm::ConstantArray::get(
+      llvm::ArrayType::get(Zero->getType(), Elts.size()), Elts);
+  else
+    Image = llvm::ConstantStruct::getAnon(Elts, /*Packed=*/true);
+  llvm::GlobalVariable *ImageGV = new llvm::GlobalVariable(
+    getModule(), Image->getType(), /*isConstant=*/true,
+    llvm::GlobalValue::PrivateLinkage, Image,
+    GV->getName() + ".upc_init");
+  ImageGV->setAlignment(Ctx.getTypeAlignInChars(EltTy).getQuantity());
+
+  uint64_t BlockSize = Quals.hasLayoutQualifier() ?
+    Quals.getLayoutQualifier() : 1;
+
+  // void __upc_shared_array_init (const void *addr, const void *image,
+  //                               size_t elem_size, size_t block_size,
+  //                               size_t nelems, size_t threads_scale);
+  llvm::Type *ArgTypes[] = { Int8PtrTy, Int8PtrTy, SizeTy, SizeTy, SizeTy,
+                             SizeTy };
+  llvm::FunctionCallee InitArrayFn = CreateRuntimeFunction(
+    llvm::FunctionType::get(VoidTy, ArgTypes, false),
+    "__upc_shared_array_init");
+
+  llvm::FunctionType *FTy = llvm::FunctionType::get(VoidTy, false);
+  llvm::Function *Fn =
+    CreateGlobalInitOrDestructFunction(FTy, "__upc_global_var_init",
+                                       getTypes().arrangeNullaryFunction(),
+                                       VD->getLocation());
+  llvm::IRBuilder<> Builder(llvm::BasicBlock::Create(VMContext, "entry", Fn));
+  llvm::Value *Args[] = {
+    llvm::ConstantExpr::getBitCast(GV, Int8PtrTy),
+    llvm::ConstantExpr::getBitCast(ImageGV, Int8PtrTy),
+    llvm::ConstantInt::get(SizeTy,
+                           Ctx.getTypeSizeInChars(EltTy).getQuantity()),
+    llvm::ConstantInt::get(SizeTy, BlockSize),
+    llvm::ConstantInt::get(SizeTy, Elts.size()),
+    llvm::ConstantInt::get(SizeTy, ThreadsScale)
+  };
+  Builder.CreateCall(InitArrayFn, Args);
+  Builder.CreateRetVoid();
+  CXXGlobalInits.push_back(Fn);
+}
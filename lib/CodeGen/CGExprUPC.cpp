@@ -43,7 +43,8 @@ static void getFileAndLine(CodeGenFunction &CGF, SourceLocation Loc,
 RValue CodeGenFunction::EmitUPCCall(
                    llvm::StringRef Name,
                    QualType ResultTy,
-                   const CallArgList& Args) {
+                   const CallArgList& Args,
+                   llvm::CallBase **CallOrInvoke) {
   ASTContext &Context = CGM.getContext();
   llvm::SmallVector<QualType, 5> ArgTypes;
 
@@ -62,7 +63,8 @@ RValue CodeGenFunction::EmitUPCCall(
       cast<llvm::FunctionType>(ConvertType(FuncType));
     llvm::FunctionCallee Fn = CGM.CreateRuntimeFunction(FTy, Name);
 
-    return EmitCall(Info, CGCallee::forDirect(Fn), ReturnValueSlot(), Args);
+    return EmitCall(Info, CGCallee::forDirect(Fn), ReturnValueSlot(), Args,
+                    CallOrInvoke);
 }
 
 llvm::Value *CodeGenFunction::EmitUPCCastSharedToLocal(llvm::Value *Value,
@@ -200,6 +202,30 @@ static llvm::Value *ConvertPTStoLLVMPtr(CodeGenFunction& CGF,
   return CGF.Builder.CreateIntToPtr(IntVal, LLPtsTy);
 }
 
+/// Record a remark describing how a shared access of type \p LTy was
+/// lowered: inline through the UPC address space if \p Callee is empty,
+/// or as a call to the runtime routine \p Callee otherwise.
+static void addUPCAccessRemark(CodeGenFunction &CGF, llvm::Instruction *I,
+                               const char *Access, bool isStrict,
+                               llvm::Type *LTy, StringRef Callee) {
+  CodeGenModule &CGM = CGF.CGM;
+  if (!CGM.shouldEmitUPCRemarks() || !I)
+    return;
+  using llvm::ore::NV;
+  uint64_t Bytes = CGM.getDataLayout().getTypeStoreSize(LTy);
+  UPCRemark &R =
+      Callee.empty()
+          ? CGM.addUPCRemark(UPCRemark::Passed, "SharedAccessInline", I)
+          : CGM.addUPCRemark(UPCRemark::Missed, "SharedAccessRuntimeCall", I);
+  R << (isStrict ? "strict" : "relaxed") << " shared "
+    << NV("Access", Access) << " of " << NV("Bytes", Bytes) << " bytes";
+  if (Callee.empty())
+    R << " lowered to an access in address space "
+      << NV("AddrSpace", UPCAddrSpace);
+  else
+    R << " lowered to a call to " << NV("Callee", Callee);
+}
+
 llvm::Value *CodeGenFunction::EmitUPCLoad(Address A,
                                           bool isStrict,
                                           llvm::Type *LTy,
@@ -213,6 +239,7 @@ llvm::Value *CodeGenFunction::EmitUPCLoad(Address A,
     if(isStrict) {
       Result->setOrdering(llvm::AtomicOrdering::SequentiallyConsistent);
     }
+    addUPCAccessRemark(*this, Result, "load", isStrict, LTy, "");
     return Result;
   }
   const ASTContext& Context = getContext();
@@ -235,7 +262,9 @@ llvm::Value *CodeGenFunction::EmitUPCLoad(Address A,
     } else {
       Name += '2';
     }
-    RValue Result = EmitUPCCall(Name, ResultTy, Args);
+    llvm::CallBase *Call = nullptr;
+    RValue Result = EmitUPCCall(Name, ResultTy, Args, &Call);
+    addUPCAccessRemark(*this, Call, "load", isStrict, LTy, Name);
     llvm::Value *Value = Result.getScalarVal();
     if (LTy->isPointerTy())
       Value = Builder.CreateIntToPtr(Value, LTy);
@@ -259,7 +288,9 @@ llvm::Value *CodeGenFunction::EmitUPCLoad(Address A,
     } else {
       Name += '3';
     }
-    EmitUPCCall(Name, getContext().VoidTy, Args);
+    llvm::CallBase *Call = nullptr;
+    EmitUPCCall(Name, getContext().VoidTy, Args, &Call);
+    addUPCAccessRemark(*this, Call, "load", isStrict, LTy, Name);
 
     return Builder.CreateLoad(Mem);
   }
@@ -304,6 +335,7 @@ void CodeGenFunction::EmitUPCStore(llvm::Value *Value,
     if(isStrict) {
       Result->setOrdering(llvm::AtomicOrdering::SequentiallyConsistent);
     }
+    addUPCAccessRemark(*this, Result, "store", isStrict, Value->getType(), "");
     return;
   }
   const ASTContext& Context = getContext();
@@ -315,7 +347,9 @@ void CodeGenFunction::EmitUPCStore(llvm::Value *Value,
   if (isStrict) Name += 's';
   if (CGM.getCodeGenOpts().UPCDebug) Name += "g";
 
-  if (const char * ID = getUPCTypeID(*this, &ValTy, Value->getType(), Size, Context.toBits(Align))) {
+  llvm::Type *LTy = Value->getType();
+  llvm::CallBase *Call = nullptr;
+  if (const char * ID = getUPCTypeID(*this, &ValTy, LTy, Size, Context.toBits(Align))) {
     Name += ID;
 
     llvm::Type *ValLTy = ConvertTypeForMem(ValTy);
@@ -336,7 +370,7 @@ void CodeGenFunction::EmitUPCStore(llvm::Value *Value,
       Name += '2';
     }
 
-    EmitUPCCall(Name, Context.VoidTy, Args);
+    EmitUPCCall(Name, Context.VoidTy, Args, &Call);
   } else {
     Name += "blk";
 
@@ -355,8 +389,9 @@ void CodeGenFunction::EmitUPCStore(llvm::Value *Value,
     } else {
       Name += '3';
     }
-    EmitUPCCall(Name, getContext().VoidTy, Args);
+    EmitUPCCall(Name, getContext().VoidTy, Args, &Call);
   }
+  addUPCAccessRemark(*this, Call, "store", isStrict, LTy, Name);
 }
 
 void CodeGenFunction::EmitUPCAggregateCopy(llvm::Value *Dest, llvm::Value *Src,
@@ -366,9 +401,8 @@ void CodeGenFunction::EmitUPCAggregateCopy(llvm::Value *Dest, llvm::Value *Src,
   QualType ArgTy = Context.getPointerType(Context.getSharedType(Context.VoidTy));
   QualType SizeType = Context.getSizeType();
   assert(DestTy->getCanonicalTypeUnqualified() == SrcTy->getCanonicalTypeUnqualified());
-  llvm::Constant *Len =
-    llvm::ConstantInt::get(ConvertType(SizeType),
-                           Context.getTypeSizeInChars(DestTy).getQuantity());
+  int64_t Bytes = Context.getTypeSizeInChars(DestTy).getQuantity();
+  llvm::Constant *Len = llvm::ConstantInt::get(ConvertType(SizeType), Bytes);
   llvm::SmallString<16> Name;
   const char *OpName;
   QualType DestArgTy, SrcArgTy;
@@ -404,7 +438,14 @@ void CodeGenFunction::EmitUPCAggregateCopy(llvm::Value *Dest, llvm::Value *Src,
   } else {
     Name += '3';
   }
-  EmitUPCCall(Name, Context.VoidTy, Args);
+  llvm::CallBase *Call = nullptr;
+  EmitUPCCall(Name, Context.VoidTy, Args, &Call);
+  if (CGM.shouldEmitUPCRemarks() && Call)
+    CGM.addUPCRemark(UPCRemark::Analysis, "AggregateCopy", Call)
+        << "shared aggregate " << llvm::ore::NV("Operation", OpName)
+        << " of " << llvm::ore::NV("Bytes", Bytes)
+        << " bytes lowered to a block transfer by "
+        << llvm::ore::NV("Callee", Name);
 }
 
 llvm::Value *CodeGenFunction::EmitUPCAtomicCmpXchg(llvm::Value *Addr,
@@ -420,11 +461,12 @@ llvm::Value *CodeGenFunction::EmitUPCPointerGetPhase(llvm::Value *Pointer) {
   unsigned PhaseBits = LangOpts.UPCPhaseBits;
   unsigned ThreadBits = LangOpts.UPCThreadBits;
   unsigned AddrBits = LangOpts.UPCAddrBits;
+  unsigned PtsBits = PhaseBits + ThreadBits + AddrBits;
   llvm::Value *Result;
   if (LangOpts.UPCPtsRep) {
     llvm::Value *Val = Builder.CreateExtractValue(Pointer, 0);
     if (LangOpts.UPCVaddrFirst) {
-      Result = Builder.CreateAnd(Val, llvm::APInt::getLowBitsSet(64, PhaseBits));
+      Result = Builder.CreateAnd(Val, llvm::APInt::getLowBitsSet(PtsBits, PhaseBits));
     } else {
       Result = Builder.CreateLShr(Val, ThreadBits + AddrBits);
     }
@@ -443,6 +485,7 @@ llvm::Value *CodeGenFunction::EmitUPCPointerGetThread(llvm::Value *Pointer) {
   unsigned PhaseBits = LangOpts.UPCPhaseBits;
   unsigned ThreadBits = LangOpts.UPCThreadBits;
   unsigned AddrBits = LangOpts.UPCAddrBits;
+  unsigned PtsBits = PhaseBits + ThreadBits + AddrBits;
   llvm::Value *Result;
   if (LangOpts.UPCPtsRep) {
     llvm::Value *Val = Builder.CreateExtractValue(Pointer, 0);
@@ -451,7 +494,7 @@ llvm::Value *CodeGenFunction::EmitUPCPointerGetThread(llvm::Value *Pointer) {
     } else {
       Val = Builder.CreateLShr(Val, AddrBits);
     }
-    Result = Builder.CreateAnd(Val, llvm::APInt::getLowBitsSet(64, ThreadBits));
+    Result = Builder.CreateAnd(Val, llvm::APInt::getLowBitsSet(PtsBits, ThreadBits));
   } else {
     Result = Builder.CreateExtractValue(Pointer, 1);
   }
@@ -463,13 +506,14 @@ llvm::Value *CodeGenFunction::EmitUPCPointerGetAddr(llvm::Value *Pointer) {
   unsigned PhaseBits = LangOpts.UPCPhaseBits;
   unsigned ThreadBits = LangOpts.UPCThreadBits;
   unsigned AddrBits = LangOpts.UPCAddrBits;
+  unsigned PtsBits = PhaseBits + ThreadBits + AddrBits;
   llvm::Value *Result;
   if (LangOpts.UPCPtsRep) {
     llvm::Value *Val = Builder.CreateExtractValue(Pointer, 0);
     if (LangOpts.UPCVaddrFirst) {
       Result = Builder.CreateLShr(Val, ThreadBits + PhaseBits);
     } else {
-      Result = Builder.CreateAnd(Val, llvm::APInt::getLowBitsSet(64, AddrBits));
+      Result = Builder.CreateAnd(Val, llvm::APInt::getLowBitsSet(PtsBits, AddrBits));
     }
   } else {
     if (LangOpts.UPCVaddrFirst) {
@@ -489,10 +533,12 @@ llvm::Value *CodeGenFunction::EmitUPCPointer(llvm::Value *Phase, llvm::Value *Th
   llvm::Value *Result = llvm::UndefValue::get(GenericPtsTy);
   if (LangOpts.UPCPtsRep) {
     // The arguments are size_t.  Convert them
-    // to the correct size.
-    Phase = Builder.CreateZExtOrTrunc(Phase, Int64Ty);
-    Thread = Builder.CreateZExtOrTrunc(Thread, Int64Ty);
-    Addr = Builder.CreateZExtOrTrunc(Addr, Int64Ty);
+    // to the correct size (64 or 128 bits).
+    llvm::Type *PtsIntTy =
+      llvm::IntegerType::get(getLLVMContext(), PhaseBits + ThreadBits + AddrBits);
+    Phase = Builder.CreateZExtOrTrunc(Phase, PtsIntTy);
+    Thread = Builder.CreateZExtOrTrunc(Thread, PtsIntTy);
+    Addr = Builder.CreateZExtOrTrunc(Addr, PtsIntTy);
     llvm::Value *Val;
     if (LangOpts.UPCVaddrFirst) {
       Val = Builder.CreateOr(Builder.CreateShl(Addr, ThreadBits + PhaseBits),
@@ -551,16 +597,33 @@ ConstantAddress CodeGenModule::getUPCMyThread() {
   return ConstantAddress(UPCMyThread, Align);
 }
 
+/// Load a variable that does not change while the program runs (THREADS,
+/// or MYTHREAD within a thread).  The load is emitted once, in the entry
+/// block, and is shared by all the uses in the function.
+static llvm::Value *EmitUPCInvariantLoad(CodeGenFunction &CGF, Address Addr,
+                                         llvm::Value *&Cache) {
+  if (Cache)
+    return Cache;
+  if (!CGF.AllocaInsertPt)
+    return CGF.Builder.CreateLoad(Addr);
+  CGBuilderTy EntryBuilder(CGF, CGF.AllocaInsertPt);
+  llvm::LoadInst *Load = EntryBuilder.CreateLoad(Addr);
+  Load->setMetadata(llvm::LLVMContext::MD_invariant_load,
+                    llvm::MDNode::get(CGF.getLLVMContext(), None));
+  Cache = Load;
+  return Load;
+}
+
 llvm::Value *CodeGenFunction::EmitUPCThreads() {
   if (uint32_t Threads = getContext().getLangOpts().UPCThreads) {
     return llvm::ConstantInt::get(IntTy, Threads);
   } else {
-    return Builder.CreateLoad(CGM.getUPCThreads());
+    return EmitUPCInvariantLoad(*this, CGM.getUPCThreads(), UPCThreadsValue);
   }
 }
 
 llvm::Value *CodeGenFunction::EmitUPCMyThread() {
-  return Builder.CreateLoad(CGM.getUPCMyThread());
+  return EmitUPCInvariantLoad(*this, CGM.getUPCMyThread(), UPCMyThreadValue);
 }
 
 
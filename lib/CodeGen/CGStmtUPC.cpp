@@ -89,6 +89,37 @@ ConstantAddress CodeGenModule::getUPCFenceVar() {
   return ConstantAddress(UPCFenceVar, Align);
 }
 
+template <typename RemarkT>
+static void emitUPCRemark(llvm::LLVMContext &Ctx, const UPCRemark &R,
+                          const llvm::Instruction *I) {
+  RemarkT D("upc", R.Name, I);
+  for (const auto &Arg : R.Args)
+    D.insert(Arg);
+  Ctx.diagnose(D);
+}
+
+void CodeGenModule::EmitUPCRemarks() {
+  llvm::LLVMContext &Ctx = getLLVMContext();
+  for (const UPCRemark &R : UPCRemarks) {
+    llvm::Value *V = R.Inst;
+    auto *I = dyn_cast_or_null<llvm::Instruction>(V);
+    if (!I || !I->getParent() || !I->getFunction())
+      continue;
+    switch (R.Kind) {
+    case UPCRemark::Passed:
+      emitUPCRemark<llvm::OptimizationRemark>(Ctx, R, I);
+      break;
+    case UPCRemark::Missed:
+      emitUPCRemark<llvm::OptimizationRemarkMissed>(Ctx, R, I);
+      break;
+    case UPCRemark::Analysis:
+      emitUPCRemark<llvm::OptimizationRemarkAnalysis>(Ctx, R, I);
+      break;
+    }
+  }
+  UPCRemarks.clear();
+}
+
 void CodeGenFunction::EmitUPCFenceStmt(const UPCFenceStmt &S) {
   Address FencePtr = CGM.getUPCFenceVar();
   FencePtr = EmitSharedVarDeclLValue(FencePtr, getContext().IntTy).getAddress();
@@ -118,8 +149,12 @@ void CodeGenFunction::EmitUPCForAllStmt(const UPCForAllStmt &S) {
 
   RunCleanupsScope ForScope(*this);
 
+  // A upc_forall nested in another one of this function runs all of its
+  // iterations, so only the outermost one maintains the depth count that
+  // the upc_forall statements of called functions test.
+  bool Nested = UPCForAllNesting > 0;
   llvm::Value *Depth = 0;
-  if (S.getAfnty()) {
+  if (S.getAfnty() && !Nested) {
     Address DepthAddr = getUPCForAllDepth(CGM);
     Depth = Builder.CreateLoad(DepthAddr);
     Builder.CreateStore(Builder.CreateNUWAdd(Depth,
@@ -190,7 +225,11 @@ void CodeGenFunction::EmitUPCForAllStmt(const UPCForAllStmt &S) {
   // Store the blocks to use for break and continue.
   BreakContinueStack.push_back(BreakContinue(LoopExit, Continue));
 
-  if (const Expr *Afnty = S.getAfnty()) {
+  const Expr *Afnty = S.getAfnty();
+  if (Afnty && Nested) {
+    if (Afnty->HasSideEffects(getContext()))
+      EmitIgnoredExpr(Afnty);
+  } else if (Afnty) {
     llvm::Value *Affinity = EmitScalarExpr(Afnty);
     if (Afnty->getType()->hasPointerToSharedRepresentation()) {
       // get threadof
@@ -224,7 +263,15 @@ void CodeGenFunction::EmitUPCForAllStmt(const UPCForAllStmt &S) {
                         Builder.CreateICmpEQ(Affinity, MyThread));
 
     llvm::BasicBlock *RealBody = createBasicBlock("upc_forall.body");
-    Builder.CreateCondBr(Test, RealBody, Continue.getBlock());
+    llvm::BranchInst *Filter =
+      Builder.CreateCondBr(Test, RealBody, Continue.getBlock());
+    if (CGM.shouldEmitUPCRemarks())
+      CGM.addUPCRemark(UPCRemark::Missed, "ForallAffinityTest", Filter)
+          << "upc_forall evaluates its "
+          << llvm::ore::NV("Affinity",
+                           Afnty->getType()->hasPointerToSharedRepresentation()
+                               ? "pointer-to-shared" : "integer")
+          << " affinity expression on every iteration of every thread";
     EmitBlock(RealBody);
   }
 
@@ -232,7 +279,11 @@ void CodeGenFunction::EmitUPCForAllStmt(const UPCForAllStmt &S) {
     // Create a separate cleanup scope for the body, in case it is not
     // a compound statement.
     RunCleanupsScope BodyScope(*this);
+    if (Afnty)
+      ++UPCForAllNesting;
     EmitStmt(S.getBody());
+    if (Afnty)
+      --UPCForAllNesting;
   }
 
   // If there is an increment, emit it next.
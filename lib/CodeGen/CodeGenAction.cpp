@@ -294,6 +294,10 @@ namespace clang {
           CodeGenOpts.getProfileUse() != CodeGenOptions::ProfileNone)
         Ctx.setDiagnosticsHotnessRequested(true);
 
+      // Now that remarks can be reported, emit the ones recorded while
+      // lowering UPC constructs.
+      Gen->CGM().EmitUPCRemarks();
+
       // Link each LinkModule into our module.
       if (LinkInModules())
         return;
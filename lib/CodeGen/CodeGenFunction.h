@@ -2662,7 +2662,8 @@ public:
   
 
   RValue EmitUPCCall(llvm::StringRef Name, QualType ResultTy,
-                     const CallArgList& Args);
+                     const CallArgList& Args,
+                     llvm::CallBase **CallOrInvoke = nullptr);
   llvm::Value *EmitUPCCastSharedToLocal(llvm::Value *Value, QualType DestTy,
                                         SourceLocation Loc);
   llvm::Value *EmitUPCBitCastZeroPhase(llvm::Value *Value, QualType DestTy);
@@ -2693,6 +2694,13 @@ public:
   llvm::Value *EmitUPCPointerGetAddr(llvm::Value *Pointer);
   llvm::Value *EmitUPCPointer(llvm::Value *Phase, llvm::Value *Thread,
                               llvm::Value *Addr);
+  /// THREADS and MYTHREAD, once loaded in the entry block.
+  llvm::Value *UPCThreadsValue = nullptr;
+  llvm::Value *UPCMyThreadValue = nullptr;
+  /// The number of enclosing upc_forall statements of this function that
+  /// have an affinity expression.
+  unsigned UPCForAllNesting = 0;
+
   llvm::Value *EmitUPCThreads();
   llvm::Value *EmitUPCMyThread();
   llvm::Value *EmitUPCPointerArithmetic(llvm::Value *LHS, llvm::Value *RHS,
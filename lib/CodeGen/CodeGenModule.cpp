@@ -88,6 +88,10 @@ static CGCXXABI *createCXXABI(CodeGenModule &CGM) {
   llvm_unreachable("invalid C++ ABI kind");
 }
 
+static bool matchesUPCRemarks(const std::shared_ptr<llvm::Regex> &Pattern) {
+  return Pattern && Pattern->match("upc");
+}
+
 CodeGenModule::CodeGenModule(ASTContext &C, const HeaderSearchOptions &HSO,
                              const PreprocessorOptions &PPO,
                              const CodeGenOptions &CGO, llvm::Module &M,
@@ -137,6 +141,14 @@ CodeGenModule::CodeGenModule(ASTContext &C, const HeaderSearchOptions &HSO,
   if (LangOpts.CUDA)
     createCUDARuntime();
 
+  // Collect UPC lowering remarks only if they are going to be reported.
+  if (LangOpts.UPC)
+    UPCRemarksEnabled =
+        !CodeGenOpts.OptRecordFile.empty() ||
+        matchesUPCRemarks(CodeGenOpts.OptimizationRemarkPattern) ||
+        matchesUPCRemarks(CodeGenOpts.OptimizationRemarkMissedPattern) ||
+        matchesUPCRemarks(CodeGenOpts.OptimizationRemarkAnalysisPattern);
+
   // Enable TBAA unless it's suppressed. ThreadSanitizer needs TBAA even at O0.
   if (LangOpts.Sanitize.has(SanitizerKind::Thread) ||
       (!CodeGenOpts.RelaxedAliasing && CodeGenOpts.OptimizationLevel > 0))
@@ -420,6 +432,27 @@ void CodeGenModule::Release() {
     else
       conf->setSection("upc_pgm_info");
     addUsedGlobal(conf);
+
+    // Refer to the symbol that names this module's pointer-to-shared
+    // layout.  The UPC runtime library defines only the symbol for
+    // the layout that it was built for, so objects that disagree
+    // on the layout fail to link.
+    const LangOptions &LangOpts = getContext().getLangOpts();
+    llvm::SmallString<64> Layout("__upc_pts_");
+    Layout += LangOpts.UPCPtsRep ? "packed_" : "struct_";
+    llvm::APInt(32, LangOpts.UPCPhaseBits).toStringUnsigned(Layout);
+    Layout += "_";
+    llvm::APInt(32, LangOpts.UPCThreadBits).toStringUnsigned(Layout);
+    Layout += "_";
+    llvm::APInt(32, LangOpts.UPCAddrBits).toStringUnsigned(Layout);
+    Layout += LangOpts.UPCVaddrFirst ? "_first" : "_last";
+    llvm::Constant *LayoutSym =
+      getModule().getOrInsertGlobal(Layout, Int8Ty);
+    llvm::GlobalVariable *LayoutRef =
+      new llvm::GlobalVariable(getModule(), LayoutSym->getType(),
+                               true, llvm::GlobalValue::InternalLinkage,
+                               LayoutSym, "__upc_pts_layout_ref");
+    addUsedGlobal(LayoutRef);
   }
   EmitDeferred();
   EmitVTablesOpportunistically();
@@ -4065,6 +4098,9 @@ void CodeGenModule::EmitGlobalVarDefinition(const VarDecl *D,
       GV->setSection("upc_shared");
   }
 
+  if (ASTTy->isArrayType() && ASTTy.getQualifiers().hasShared() && InitExpr)
+    EmitUPCSharedArrayInitFunc(D, GV);
+
   if (D->getTLSKind() && !GV->isThreadLocal()) {
     if (D->getTLSKind() == VarDecl::TLS_Dynamic)
       CXXThreadLocals.push_back(D);
@@ -32,6 +32,7 @@
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/StringMap.h"
+#include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/ValueHandle.h"
 #include "llvm/Transforms/Utils/SanitizerStats.h"
@@ -272,6 +273,29 @@ public:
   virtual void emitDispose(CodeGenFunction &CGF, Address field) = 0;
 };
 
+/// A "-Rpass=upc" optimization remark about the lowering of a UPC
+/// construct, attached to the instruction that implements it.
+struct UPCRemark {
+  enum RemarkKind { Passed, Missed, Analysis };
+
+  RemarkKind Kind;
+  const char *Name;
+  llvm::WeakTrackingVH Inst;
+  SmallVector<llvm::DiagnosticInfoOptimizationBase::Argument, 4> Args;
+
+  UPCRemark(RemarkKind Kind, const char *Name, llvm::Instruction *Inst)
+      : Kind(Kind), Name(Name), Inst(Inst) {}
+
+  UPCRemark &operator<<(StringRef S) {
+    Args.emplace_back(S);
+    return *this;
+  }
+  UPCRemark &operator<<(llvm::DiagnosticInfoOptimizationBase::Argument A) {
+    Args.push_back(std::move(A));
+    return *this;
+  }
+};
+
 /// This class organizes the cross-function state that is used while generating
 /// LLVM code.
 class CodeGenModule : public CodeGenTypeCache {
@@ -507,6 +531,17 @@ private:
   llvm::Constant *UPCMyThread = nullptr;
   llvm::Constant *UPCFenceVar = nullptr;
 
+  /// @}
+
+  /// @name UPC Optimization Remarks
+  /// @{
+
+  /// Remarks about the lowering of UPC constructs.  They are collected
+  /// during IR generation, because the backend only installs its
+  /// diagnostic handler and optimization record streamer afterwards.
+  std::vector<UPCRemark> UPCRemarks;
+  bool UPCRemarksEnabled = false;
+
   /// @}
   
   /// Map used to be sure we don't emit the same CompoundLiteral twice.
@@ -1052,6 +1087,23 @@ public:
   ConstantAddress getUPCMyThread();
   ConstantAddress getUPCFenceVar();
 
+  /// Return true if UPC optimization remarks are requested, either by
+  /// a -Rpass family option matching "upc" or by an optimization record.
+  bool shouldEmitUPCRemarks() const { return UPCRemarksEnabled; }
+
+  /// Record a UPC optimization remark about the instruction \p I.
+  /// The remark is emitted by EmitUPCRemarks.
+  UPCRemark &addUPCRemark(UPCRemark::RemarkKind Kind, const char *Name,
+                          llvm::Instruction *I) {
+    UPCRemarks.emplace_back(Kind, Name, I);
+    return UPCRemarks.back();
+  }
+
+  /// Emit the recorded UPC optimization remarks through the LLVM context.
+  /// Remarks about instructions deleted since they were recorded are
+  /// dropped.
+  void EmitUPCRemarks();
+
   ///@name Custom Blocks Runtime Interfaces
   ///@{
 
@@ -1256,6 +1308,10 @@ public:
   // Emit the initializer for a shared array, if it needs special treatment
   llvm::Constant *MaybeEmitUPCSharedArrayInits(const VarDecl *VD);
 
+  // Emit the routine that initializes the calling thread's part of a
+  // statically initialized shared array
+  void EmitUPCSharedArrayInitFunc(const VarDecl *VD, llvm::GlobalVariable *GV);
+
   /// Emit code for a singal global function or var decl. Forward declarations
   /// are emitted lazily.
   void EmitGlobal(GlobalDecl D);
@@ -710,7 +710,10 @@ llvm::Type *CodeGenTypes::GetUPCPointerToSharedType() {
   if (Context.getLangOpts().UPCPtsRep)
     UPCPtsType = llvm::StructType::create(
       "__upc_shared_pointer_type",
-      llvm::Type::getInt64Ty(getLLVMContext()));
+      llvm::Type::getIntNTy(getLLVMContext(),
+                            Context.getLangOpts().UPCPhaseBits +
+                            Context.getLangOpts().UPCThreadBits +
+                            Context.getLangOpts().UPCAddrBits));
   else if (Context.getLangOpts().UPCVaddrFirst) {
     if (Context.getLangOpts().UPCAddrBits == 64) {
       UPCPtsType = llvm::StructType::create(
@@ -2629,9 +2629,11 @@ void X86_64ABIInfo::classify(QualType Ty, uint64_t OffsetBase,
 
   // A UPC pointer-to-shared is treated as either
   // an integer or a pair of integers depending
-  // on the PTS representation
+  // on the PTS representation (and, for the packed
+  // representation, on its size)
   if (Ty->hasPointerToSharedRepresentation()) {
-    if (getContext().getLangOpts().UPCPtsRep == 0)
+    if (getContext().getLangOpts().UPCPtsRep == 0 ||
+        getContext().getTypeSize(Ty) > 64)
       Lo = Hi = Integer;
     else
       Current = Integer;
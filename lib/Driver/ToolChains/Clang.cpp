@@ -25,6 +25,7 @@
 #include "clang/Basic/LangOptions.h"
 #include "clang/Basic/ObjCRuntime.h"
 #include "clang/Basic/Version.h"
+#include "clang/Config/config.h"
 #include "clang/Driver/Distro.h"
 #include "clang/Driver/DriverDiagnostic.h"
 #include "clang/Driver/Options.h"
@@ -5017,6 +5018,21 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
 
   Args.AddAllArgs(CmdArgs, options::OPT_fupc_inline_lib,
                   options::OPT_fno_upc_inline_lib);
+#ifdef LIBUPC_ENABLE_LTO_LIB
+  // The UPC runtime bitcode library linked under LTO provides the runtime
+  // accesses for inlining, so don't parse the inline library in every
+  // translation unit.
+  if (D.CCCIsUPC() && D.isUsingLTO() &&
+      Args.hasFlag(options::OPT_fupc_lto_lib, options::OPT_fno_upc_lto_lib,
+                   true) &&
+      !Args.hasArg(options::OPT_fupc_inline_lib,
+                   options::OPT_fno_upc_inline_lib))
+    CmdArgs.push_back("-fno-upc-inline-lib");
+#else
+  // There is no UPC runtime bitcode library to link.
+  Args.ClaimAllArgs(options::OPT_fupc_lto_lib);
+  Args.ClaimAllArgs(options::OPT_fno_upc_lto_lib);
+#endif
   Args.AddAllArgs(CmdArgs, options::OPT_fupc_pre_include,
                   options::OPT_fno_upc_pre_include);
   Args.AddAllArgs(CmdArgs, options::OPT_fupc_ir,
@@ -5026,6 +5042,10 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
                    options::OPT_fno_upc_debug, false))
     CmdArgs.push_back("-fupc-debug");
 
+  if (Args.hasFlag(options::OPT_fupc_release_lib,
+                   options::OPT_fno_upc_release_lib, false))
+    CmdArgs.push_back("-fupc-release-lib");
+
   // -finput_charset=UTF-8 is default. Reject others
   if (Arg *inputCharset = Args.getLastArg(options::OPT_finput_charset_EQ)) {
     StringRef value = inputCharset->getValue();
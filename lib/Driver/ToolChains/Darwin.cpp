@@ -48,7 +48,8 @@ static const char *GetUPCLibOption(const ArgList &Args) {
       for (int i = 0; i < 3; ++i)
         if (Bits[i].getAsInteger(10, Values[i]) || Values[i] <= 0)
           okay = false;
-      if (Values[0] + Values[1] + Values[2] != 64)
+      if (Values[0] + Values[1] + Values[2] != 64 &&
+          Values[0] + Values[1] + Values[2] != 128)
         okay = false;
     } else {
       okay = false;
@@ -64,6 +65,10 @@ static const char *GetUPCLibOption(const ArgList &Args) {
       }
     }
   }
+  if (Args.hasFlag(options::OPT_fupc_release_lib,
+                   options::OPT_fno_upc_release_lib, false)) {
+    Buf += "-r";
+  }
   return Args.MakeArgString(Buf);
 }
 
@@ -615,7 +620,9 @@ void darwin::Linker::ConstructJob(Compilation &C, const JobAction &JA,
     const Driver &D = ToolChain.getDriver();
     if (D.CCCIsUPC() && !Args.hasArg(options::OPT_nostdlib)) {
       CmdArgs.push_back(GetUPCLibOption(Args));
-#ifdef LIBUPC_ENABLE_OMP_CHECKS
+#if !defined(LIBUPC_PORTALS4) || defined(LIBUPC_ENABLE_OMP_CHECKS)
+      // The SMP runtime's memory copy helper threads, and the OpenMP
+      // thread checks, use POSIX threads.
       CmdArgs.push_back("-lpthread");
 #endif
     }
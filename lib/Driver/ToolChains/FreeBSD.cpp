@@ -11,6 +11,7 @@
 #include "Arch/Mips.h"
 #include "Arch/Sparc.h"
 #include "CommonArgs.h"
+#include "clang/Config/config.h"
 #include "clang/Driver/Compilation.h"
 #include "clang/Driver/Options.h"
 #include "clang/Driver/SanitizerArgs.h"
@@ -48,7 +49,8 @@ static const char *GetUPCLibOption(const ArgList &Args) {
       for (int i = 0; i < 3; ++i)
         if (Bits[i].getAsInteger(10, Values[i]) || Values[i] <= 0)
           okay = false;
-      if (Values[0] + Values[1] + Values[2] != 64)
+      if (Values[0] + Values[1] + Values[2] != 64 &&
+          Values[0] + Values[1] + Values[2] != 128)
         okay = false;
     } else {
       okay = false;
@@ -64,9 +66,20 @@ static const char *GetUPCLibOption(const ArgList &Args) {
       }
     }
   }
+  if (Args.hasFlag(options::OPT_fupc_release_lib,
+                   options::OPT_fno_upc_release_lib, false)) {
+    Buf += "-r";
+  }
   return Args.MakeArgString(Buf);
 }
 
+#ifdef LIBUPC_ENABLE_LTO_LIB
+static const char *GetUPCLTOLibOption(const ArgList &Args, LTOKind Mode) {
+  return Args.MakeArgString(Twine(GetUPCLibOption(Args)) +
+                            (Mode == LTOK_Thin ? "-thinlto" : "-lto"));
+}
+#endif
+
 static const char *GetUPCBeginFile(const ArgList &Args) {
   const char *upc_crtbegin;
   if (Args.hasArg(options::OPT_static))
@@ -335,12 +348,21 @@ void freebsd::Linker::ConstructJob(Compilation &C, const JobAction &JA,
   if (D.CCCIsUPC() && !Args.hasArg(options::OPT_nostdlib)) {
 #ifdef LIBUPC_LINK_SCRIPT
     CmdArgs.push_back(Args.MakeArgString("-T" + getToolChain().GetFilePath("upc.ld")));
+#endif
+#ifdef LIBUPC_ENABLE_LTO_LIB
+    // Link the bitcode library of the runtime's access, barrier and atomic
+    // paths ahead of the runtime library, so that LTO can inline them.
+    if (D.isUsingLTO() && Args.hasFlag(options::OPT_fupc_lto_lib,
+                                       options::OPT_fno_upc_lto_lib, true))
+      CmdArgs.push_back(GetUPCLTOLibOption(Args, D.getLTOMode()));
 #endif
     CmdArgs.push_back(GetUPCLibOption(Args));
 #ifdef LIBUPC_ENABLE_BACKTRACE
     CmdArgs.push_back("-lexecinfo");
 #endif
-#ifdef LIBUPC_ENABLE_OMP_CHECKS
+#if !defined(LIBUPC_PORTALS4) || defined(LIBUPC_ENABLE_OMP_CHECKS)
+    // The SMP runtime's memory copy helper threads, and the OpenMP
+    // thread checks, use POSIX threads.
     CmdArgs.push_back("-lpthread");
 #endif
   }
@@ -79,7 +79,8 @@ static const char *GetUPCLibOption(const ArgList &Args) {
       for (int i = 0; i < 3; ++i)
         if (Bits[i].getAsInteger(10, Values[i]) || Values[i] <= 0)
           okay = false;
-      if (Values[0] + Values[1] + Values[2] != 64)
+      if (Values[0] + Values[1] + Values[2] != 64 &&
+          Values[0] + Values[1] + Values[2] != 128)
         okay = false;
     } else {
       okay = false;
@@ -95,9 +96,20 @@ static const char *GetUPCLibOption(const ArgList &Args) {
       }
     }
   }
+  if (Args.hasFlag(options::OPT_fupc_release_lib,
+                   options::OPT_fno_upc_release_lib, false)) {
+    Buf += "-r";
+  }
   return Args.MakeArgString(Buf);
 }
 
+#ifdef LIBUPC_ENABLE_LTO_LIB
+static const char *GetUPCLTOLibOption(const ArgList &Args, LTOKind Mode) {
+  return Args.MakeArgString(Twine(GetUPCLibOption(Args)) +
+                            (Mode == LTOK_Thin ? "-thinlto" : "-lto"));
+}
+#endif
+
 static const char *GetUPCBeginFile(const ArgList &Args) {
   const char *upc_crtbegin;
   if (Args.hasArg(options::OPT_static))
@@ -608,6 +620,13 @@ void tools::gnutools::Linker::ConstructJob(Compilation &C, const JobAction &JA,
   if (D.CCCIsUPC() && !Args.hasArg(options::OPT_nostdlib)) {
 #ifdef LIBUPC_LINK_SCRIPT
     CmdArgs.push_back(Args.MakeArgString("-T" + ToolChain.GetFilePath("upc.ld")));
+#endif
+#ifdef LIBUPC_ENABLE_LTO_LIB
+    // Link the bitcode library of the runtime's access, barrier and atomic
+    // paths ahead of the runtime library, so that LTO can inline them.
+    if (D.isUsingLTO() && Args.hasFlag(options::OPT_fupc_lto_lib,
+                                       options::OPT_fno_upc_lto_lib, true))
+      CmdArgs.push_back(GetUPCLTOLibOption(Args, D.getLTOMode()));
 #endif
     CmdArgs.push_back(GetUPCLibOption(Args));
 #ifdef LIBUPC_PORTALS4
@@ -619,9 +638,9 @@ void tools::gnutools::Linker::ConstructJob(Compilation &C, const JobAction &JA,
     CmdArgs.push_back("-lportals_runtime");
 #endif
 #endif
-#if defined(LIBUPC_PORTALS4) || LIBUPC_ENABLE_OMP_CHECKS
+    // The SMP runtime's memory copy helper threads, the Portals4
+    // libraries and the OpenMP thread checks use POSIX threads.
     CmdArgs.push_back("-lpthread");
-#endif
 #ifdef LIBUPC_ENABLE_NUMA
     CmdArgs.push_back("-lnuma");
 #endif
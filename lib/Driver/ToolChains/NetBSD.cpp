@@ -11,6 +11,7 @@
 #include "Arch/Mips.h"
 #include "Arch/Sparc.h"
 #include "CommonArgs.h"
+#include "clang/Config/config.h"
 #include "clang/Driver/Compilation.h"
 #include "clang/Driver/Driver.h"
 #include "clang/Driver/Options.h"
@@ -49,7 +50,8 @@ static const char *GetUPCLibOption(const ArgList &Args) {
       for (int i = 0; i < 3; ++i)
         if (Bits[i].getAsInteger(10, Values[i]) || Values[i] <= 0)
           okay = false;
-      if (Values[0] + Values[1] + Values[2] != 64)
+      if (Values[0] + Values[1] + Values[2] != 64 &&
+          Values[0] + Values[1] + Values[2] != 128)
         okay = false;
     } else {
       okay = false;
@@ -65,6 +67,10 @@ static const char *GetUPCLibOption(const ArgList &Args) {
       }
     }
   }
+  if (Args.hasFlag(options::OPT_fupc_release_lib,
+                   options::OPT_fno_upc_release_lib, false)) {
+    Buf += "-r";
+  }
   return Args.MakeArgString(Buf);
 }
 
@@ -334,7 +340,9 @@ void netbsd::Linker::ConstructJob(Compilation &C, const JobAction &JA,
 #ifdef LIBUPC_ENABLE_BACKTRACE
     CmdArgs.push_back("-lexecinfo");
 #endif
-#ifdef LIBUPC_ENABLE_OMP_CHECKS
+#if !defined(LIBUPC_PORTALS4) || defined(LIBUPC_ENABLE_OMP_CHECKS)
+    // The SMP runtime's memory copy helper threads, and the OpenMP
+    // thread checks, use POSIX threads.
     CmdArgs.push_back("-lpthread");
 #endif
   }
@@ -2785,7 +2785,11 @@ static void ParseLangArgs(LangOptions &Opts, ArgList &Args, InputKind IK,
       for (int i = 0; i < 3; ++i)
         if (Bits[i].getAsInteger(10, Values[i]) || Values[i] <= 0)
           okay = false;
-      if (Values[0] + Values[1] + Values[2] != 64)
+      // The packed representation is either a 64 bit value, or
+      // a 128 bit value that allows for more threads and a larger
+      // shared address space.
+      if (Values[0] + Values[1] + Values[2] != 64 &&
+          Values[0] + Values[1] + Values[2] != 128)
         okay = false;
     } else {
       okay = false;
@@ -3085,6 +3089,9 @@ static void ParseLangArgs(LangOptions &Opts, ArgList &Args, InputKind IK,
   if (Opts.UPC && Args.hasArg(OPT_fupc_ir))
     Opts.UPCGenIr = true;
 
+  if (Opts.UPC && Args.hasArg(OPT_fupc_release_lib))
+    Opts.UPCReleaseLib = true;
+
   // This is the __NO_INLINE__ define, which just depends on things like the
   // optimization level and -fno-inline, not actually whether the backend has
   // inlining enabled.
@@ -3531,6 +3538,28 @@ bool CompilerInvocation::CreateFromArgs(CompilerInvocation &Res,
       Res.getLangOpts()->UPCThreadBits = 16;
       Res.getLangOpts()->UPCAddrBits = 32;
     }
+    // The 128 bit packed representation is only supported
+    // on 64 bit targets.
+    if (Res.getLangOpts()->UPCPtsRep &&
+        Res.getLangOpts()->UPCPhaseBits + Res.getLangOpts()->UPCThreadBits +
+          Res.getLangOpts()->UPCAddrBits > 64 &&
+        !CTriple.isArch64Bit()) {
+      Diags.Report(diag::err_drv_upc_wide_pts_unsupported)
+        << CTriple.getArchName();
+      Success = false;
+    }
+    // The lowering of pointers-to-shared to LLVM pointers packs the
+    // thread and the address into 64 bits.
+    if (Res.getLangOpts()->UPCGenIr && Res.getLangOpts()->UPCPtsRep &&
+        Res.getLangOpts()->UPCPhaseBits + Res.getLangOpts()->UPCThreadBits +
+          Res.getLangOpts()->UPCAddrBits > 64) {
+      Diags.Report(diag::err_drv_argument_not_allowed_with)
+        << Args.getLastArg(OPT_fupc_ir)->getAsString(Args)
+        << ("-fupc-packed-bits=" +
+            Args.getLastArgValue(OPT_fupc_packed_bits_EQ, UPC_PACKED_BITS))
+               .str();
+      Success = false;
+    }
     // Disable UPC shared pointer lowering to LLVM on 32 bits
     if (CTriple.isArch32Bit())
       Res.getLangOpts()->UPCGenIr = false;
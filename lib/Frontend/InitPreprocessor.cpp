@@ -445,6 +445,9 @@ static void InitializeStandardPredefinedMacros(const TargetInfo &TI,
     if (LangOpts.UPCGenIr) {
       Builder.defineMacro("__UPC_SHARED_IR__", "1");
     }
+    if (LangOpts.UPCReleaseLib) {
+      Builder.defineMacro("__UPC_RELEASE_LIB__", "1");
+    }
   }
 
   // OpenCL v1.0/1.1 s6.9, v1.2/2.0 s6.10: Preprocessor Directives and Macros.
@@ -0,0 +1,525 @@
+//==- UPCPerformanceChecker.cpp - UPC performance checks ---------*- C++ -*-==//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines a set of flow-insensitive checks for UPC code that
+//  communicates inefficiently: fine-grained or strict shared accesses in
+//  loops, upc_forall loops with the wrong affinity, bulk transfers issued
+//  once per iteration and pointer-to-shared arithmetic on pointers that
+//  could be private.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/StaticAnalyzer/Checkers/BuiltinCheckerRegistration.h"
+#include "clang/AST/StmtVisitor.h"
+#include "clang/Analysis/AnalysisDeclContext.h"
+#include "clang/Lex/Lexer.h"
+#include "clang/StaticAnalyzer/Core/BugReporter/BugReporter.h"
+#include "clang/StaticAnalyzer/Core/Checker.h"
+#include "clang/StaticAnalyzer/Core/PathSensitive/AnalysisManager.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace clang;
+using namespace ento;
+
+static const char *const UPCPerformanceCategory = "UPC performance";
+
+namespace {
+struct ChecksFilter {
+  DefaultBool check_UPCRemoteAccessInLoop;
+  DefaultBool check_UPCForallAffinity;
+  DefaultBool check_UPCStrictAccessInLoop;
+  DefaultBool check_UPCTransferInLoop;
+  DefaultBool check_UPCPrivatizablePointer;
+
+  CheckName checkName_UPCRemoteAccessInLoop;
+  CheckName checkName_UPCForallAffinity;
+  CheckName checkName_UPCStrictAccessInLoop;
+  CheckName checkName_UPCTransferInLoop;
+  CheckName checkName_UPCPrivatizablePointer;
+};
+
+class WalkAST : public ConstStmtVisitor<WalkAST> {
+  BugReporter &BR;
+  AnalysisDeclContext *AC;
+  const ChecksFilter &Filter;
+
+  /// The enclosing loops, innermost last.
+  SmallVector<const Stmt *, 4> Loops;
+  /// The affinity expression of the innermost enclosing upc_forall.
+  const Expr *Affinity = nullptr;
+  /// True while visiting the condition or increment of the innermost loop.
+  bool InLoopControl = false;
+  /// The (loop, declaration, check) triples already reported, so that each
+  /// check reports a variable once per loop.
+  llvm::DenseSet<std::pair<std::pair<const Stmt *, const Decl *>, unsigned>>
+      Reported;
+
+  enum CheckKind { CK_Remote, CK_Strict, CK_Pointer };
+
+public:
+  WalkAST(BugReporter &br, AnalysisDeclContext *ac, const ChecksFilter &f)
+      : BR(br), AC(ac), Filter(f) {}
+
+  void VisitStmt(const Stmt *S) { VisitChildren(S); }
+  void VisitForStmt(const ForStmt *S);
+  void VisitWhileStmt(const WhileStmt *S);
+  void VisitDoStmt(const DoStmt *S);
+  void VisitUPCForAllStmt(const UPCForAllStmt *S);
+  void VisitImplicitCastExpr(const ImplicitCastExpr *E);
+  void VisitBinaryOperator(const BinaryOperator *E);
+  void VisitUnaryOperator(const UnaryOperator *E);
+  void VisitArraySubscriptExpr(const ArraySubscriptExpr *E);
+  void VisitCallExpr(const CallExpr *E);
+
+  void VisitChildren(const Stmt *S);
+
+private:
+  void visitLoop(const Stmt *Loop, const Stmt *Control1,
+                 const Stmt *Control2, const Stmt *Body);
+  bool isLocalAccess(const Expr *E, const Expr *Afnty) const;
+  void collectSharedAccesses(const Stmt *S,
+                             SmallVectorImpl<const Expr *> &Accesses) const;
+  bool shouldReport(const Expr *E, CheckKind Kind);
+  StringRef getSourceText(const Expr *E) const;
+  void report(CheckName Check, StringRef BugName, StringRef Msg,
+              const Expr *E);
+
+  // Checker-specific methods.
+  void checkAccess(const Expr *E);
+  void checkForallAffinity(const UPCForAllStmt *S);
+  void checkPointerArith(const Expr *Ptr, const Expr *E);
+  void checkTransfer(const CallExpr *CE);
+};
+} // end anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// Helpers.
+//===----------------------------------------------------------------------===//
+
+/// Return true if \p E is a shared lvalue of scalar type.
+static bool isSharedScalarLValue(const Expr *E) {
+  QualType T = E->getType();
+  return T.getQualifiers().hasShared() && T->isScalarType();
+}
+
+static bool isSameExpr(ASTContext &Ctx, const Expr *E1, const Expr *E2) {
+  llvm::FoldingSetNodeID ID1, ID2;
+  E1->IgnoreParenImpCasts()->Profile(ID1, Ctx, true);
+  E2->IgnoreParenImpCasts()->Profile(ID2, Ctx, true);
+  return ID1 == ID2;
+}
+
+/// Return the variable an access or pointer expression is rooted at.
+static const Decl *getRootDecl(const Expr *E) {
+  while (true) {
+    E = E->IgnoreParenCasts();
+    if (const auto *ASE = dyn_cast<ArraySubscriptExpr>(E))
+      E = ASE->getBase();
+    else if (const auto *ME = dyn_cast<MemberExpr>(E))
+      E = ME->getBase();
+    else if (const auto *UO = dyn_cast<UnaryOperator>(E)) {
+      if (UO->getOpcode() != UO_Deref && UO->getOpcode() != UO_AddrOf)
+        return nullptr;
+      E = UO->getSubExpr();
+    } else if (const auto *DRE = dyn_cast<DeclRefExpr>(E))
+      return DRE->getDecl();
+    else
+      return nullptr;
+  }
+}
+
+/// Return true if \p S refers to one of \p Vars.
+static bool refersTo(const Stmt *S,
+                     const llvm::SmallPtrSetImpl<const Decl *> &Vars) {
+  if (!S)
+    return false;
+  if (const auto *DRE = dyn_cast<DeclRefExpr>(S))
+    if (Vars.count(DRE->getDecl()))
+      return true;
+  for (const Stmt *Child : S->children())
+    if (refersTo(Child, Vars))
+      return true;
+  return false;
+}
+
+/// Collect the variables referenced by \p S.
+static void collectVars(const Stmt *S,
+                        llvm::SmallPtrSetImpl<const Decl *> &Vars) {
+  if (!S)
+    return;
+  if (const auto *DRE = dyn_cast<DeclRefExpr>(S))
+    if (isa<VarDecl>(DRE->getDecl()))
+      Vars.insert(DRE->getDecl());
+  for (const Stmt *Child : S->children())
+    collectVars(Child, Vars);
+}
+
+void WalkAST::VisitChildren(const Stmt *S) {
+  for (const Stmt *Child : S->children())
+    if (Child)
+      Visit(Child);
+}
+
+void WalkAST::visitLoop(const Stmt *Loop, const Stmt *Control1,
+                        const Stmt *Control2, const Stmt *Body) {
+  bool SavedInLoopControl = InLoopControl;
+  Loops.push_back(Loop);
+  InLoopControl = true;
+  if (Control1)
+    Visit(Control1);
+  if (Control2)
+    Visit(Control2);
+  InLoopControl = false;
+  if (Body)
+    Visit(Body);
+  Loops.pop_back();
+  InLoopControl = SavedInLoopControl;
+}
+
+void WalkAST::VisitForStmt(const ForStmt *S) {
+  if (S->getInit())
+    Visit(S->getInit());
+  visitLoop(S, S->getCond(), S->getInc(), S->getBody());
+}
+
+void WalkAST::VisitWhileStmt(const WhileStmt *S) {
+  visitLoop(S, S->getCond(), nullptr, S->getBody());
+}
+
+void WalkAST::VisitDoStmt(const DoStmt *S) {
+  visitLoop(S, S->getCond(), nullptr, S->getBody());
+}
+
+void WalkAST::VisitUPCForAllStmt(const UPCForAllStmt *S) {
+  if (S->getInit())
+    Visit(S->getInit());
+  if (S->getAfnty())
+    Visit(S->getAfnty());
+  if (Filter.check_UPCForallAffinity)
+    checkForallAffinity(S);
+  const Expr *SavedAffinity = Affinity;
+  Affinity = S->getAfnty();
+  visitLoop(S, S->getCond(), S->getInc(), S->getBody());
+  Affinity = SavedAffinity;
+}
+
+void WalkAST::VisitImplicitCastExpr(const ImplicitCastExpr *E) {
+  if (E->getCastKind() == CK_LValueToRValue &&
+      isSharedScalarLValue(E->getSubExpr()))
+    checkAccess(E->getSubExpr());
+  VisitChildren(E);
+}
+
+void WalkAST::VisitBinaryOperator(const BinaryOperator *E) {
+  if (E->isAssignmentOp() && isSharedScalarLValue(E->getLHS()))
+    checkAccess(E->getLHS());
+  switch (E->getOpcode()) {
+  case BO_Add:
+  case BO_Sub:
+  case BO_AddAssign:
+  case BO_SubAssign:
+    if (E->getLHS()->getType()->hasPointerToSharedRepresentation())
+      checkPointerArith(E->getLHS(), E);
+    else if (E->getRHS()->getType()->hasPointerToSharedRepresentation())
+      checkPointerArith(E->getRHS(), E);
+    break;
+  default:
+    break;
+  }
+  VisitChildren(E);
+}
+
+void WalkAST::VisitUnaryOperator(const UnaryOperator *E) {
+  if (E->isIncrementDecrementOp()) {
+    if (isSharedScalarLValue(E->getSubExpr()))
+      checkAccess(E->getSubExpr());
+    if (E->getSubExpr()->getType()->hasPointerToSharedRepresentation())
+      checkPointerArith(E->getSubExpr(), E);
+  }
+  VisitChildren(E);
+}
+
+void WalkAST::VisitArraySubscriptExpr(const ArraySubscriptExpr *E) {
+  // Subscripting a shared array is an array access; subscripting a
+  // pointer-to-shared variable is pointer arithmetic.
+  const Expr *Base = E->getBase()->IgnoreParenImpCasts();
+  if (const auto *DRE = dyn_cast<DeclRefExpr>(Base))
+    if (DRE->getType()->hasPointerToSharedRepresentation())
+      checkPointerArith(DRE, E);
+  VisitChildren(E);
+}
+
+void WalkAST::VisitCallExpr(const CallExpr *E) {
+  if (Filter.check_UPCTransferInLoop)
+    checkTransfer(E);
+  VisitChildren(E);
+}
+
+/// Return true if \p E is known to access shared data with affinity to the
+/// thread executing the enclosing upc_forall iteration, or to MYTHREAD.
+/// Accesses that cannot be analyzed in a upc_forall with an affinity that
+/// cannot be analyzed either are assumed to be local.
+bool WalkAST::isLocalAccess(const Expr *E, const Expr *Afnty) const {
+  ASTContext &Ctx = BR.getContext();
+  E = E->IgnoreParens();
+  const Expr *A = Afnty ? Afnty->IgnoreParenImpCasts() : nullptr;
+  if (const auto *UO = dyn_cast_or_null<UnaryOperator>(A))
+    if (UO->getOpcode() == UO_AddrOf && isSameExpr(Ctx, UO->getSubExpr(), E))
+      return true;
+  if (const auto *ASE = dyn_cast<ArraySubscriptExpr>(E)) {
+    // A shared array with a block size of one starts on thread 0, so
+    // element 'i' has affinity to thread 'i % THREADS'.
+    const Expr *Base = ASE->getBase()->IgnoreParenImpCasts();
+    bool CyclicArray = isa<DeclRefExpr>(Base) &&
+                       Base->getType()->isArrayType() &&
+                       ASE->getType().getQualifiers().getLayoutQualifier() == 1;
+    const Expr *Idx = ASE->getIdx()->IgnoreParenImpCasts();
+    if (CyclicArray && isa<UPCMyThreadExpr>(Idx))
+      return true;
+    if (CyclicArray && A && A->getType()->isIntegerType() &&
+        isSameExpr(Ctx, Idx, A))
+      return true;
+  }
+  // An affinity that is neither '&lvalue' nor an integer expression cannot
+  // be compared with the access.
+  if (A && !A->getType()->isIntegerType() &&
+      !(isa<UnaryOperator>(A) &&
+        cast<UnaryOperator>(A)->getOpcode() == UO_AddrOf))
+    return true;
+  return false;
+}
+
+void WalkAST::collectSharedAccesses(
+    const Stmt *S, SmallVectorImpl<const Expr *> &Accesses) const {
+  if (!S)
+    return;
+  if (const auto *ICE = dyn_cast<ImplicitCastExpr>(S)) {
+    if (ICE->getCastKind() == CK_LValueToRValue &&
+        isSharedScalarLValue(ICE->getSubExpr()))
+      Accesses.push_back(ICE->getSubExpr()->IgnoreParens());
+  } else if (const auto *BO = dyn_cast<BinaryOperator>(S)) {
+    if (BO->isAssignmentOp() && isSharedScalarLValue(BO->getLHS()))
+      Accesses.push_back(BO->getLHS()->IgnoreParens());
+  }
+  for (const Stmt *Child : S->children())
+    collectSharedAccesses(Child, Accesses);
+}
+
+bool WalkAST::shouldReport(const Expr *E, CheckKind Kind) {
+  const Decl *D = getRootDecl(E);
+  if (!D)
+    return true;
+  return Reported.insert({{Loops.back(), D}, Kind}).second;
+}
+
+StringRef WalkAST::getSourceText(const Expr *E) const {
+  return Lexer::getSourceText(
+      CharSourceRange::getTokenRange(E->getSourceRange()),
+      BR.getSourceManager(), BR.getContext().getLangOpts());
+}
+
+void WalkAST::report(CheckName Check, StringRef BugName, StringRef Msg,
+                     const Expr *E) {
+  PathDiagnosticLocation Loc =
+      PathDiagnosticLocation::createBegin(E, BR.getSourceManager(), AC);
+  BR.EmitBasicReport(AC->getDecl(), Check, BugName, UPCPerformanceCategory,
+                     Msg, Loc, E->getSourceRange());
+}
+
+//===----------------------------------------------------------------------===//
+// Check: fine-grained and strict shared accesses in loops.
+//===----------------------------------------------------------------------===//
+
+void WalkAST::checkAccess(const Expr *E) {
+  if (Loops.empty())
+    return;
+
+  if (E->getType().getQualifiers().hasStrict()) {
+    // Strict accesses in a loop condition are usually synchronization
+    // (spin waits); only those in the body are reported.
+    if (Filter.check_UPCStrictAccessInLoop && !InLoopControl &&
+        shouldReport(E, CK_Strict)) {
+      SmallString<256> Buf;
+      llvm::raw_svector_ostream OS(Buf);
+      OS << "Each iteration performs a strict access to '" << getSourceText(E)
+         << "', which cannot be overlapped with other shared accesses; use a "
+            "relaxed access in the loop and a single 'upc_fence' after it";
+      report(Filter.checkName_UPCStrictAccessInLoop,
+             "Strict shared access in a loop", OS.str(), E);
+    }
+    return;
+  }
+
+  if (Filter.check_UPCRemoteAccessInLoop && !isLocalAccess(E, Affinity) &&
+      shouldReport(E, CK_Remote)) {
+    SmallString<256> Buf;
+    llvm::raw_svector_ostream OS(Buf);
+    OS << "Each iteration accesses shared '" << getSourceText(E)
+       << "' with a separate, possibly remote, communication operation; copy "
+          "the data to a private buffer with 'upc_memget' before the loop "
+          "(and back with 'upc_memput'), or distribute the iterations with "
+          "'upc_forall' so that the accesses have affinity to MYTHREAD";
+    report(Filter.checkName_UPCRemoteAccessInLoop,
+           "Fine-grained shared access in a loop", OS.str(), E);
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Check: upc_forall affinity that matches no access of the loop body.
+//===----------------------------------------------------------------------===//
+
+void WalkAST::checkForallAffinity(const UPCForAllStmt *S) {
+  const Expr *A = S->getAfnty();
+  if (!A)
+    return;
+  A = A->IgnoreParenImpCasts();
+  bool AddrOf =
+      isa<UnaryOperator>(A) && cast<UnaryOperator>(A)->getOpcode() == UO_AddrOf;
+  if (!AddrOf && !A->getType()->isIntegerType())
+    return;
+
+  SmallVector<const Expr *, 8> Accesses;
+  collectSharedAccesses(S->getBody(), Accesses);
+  const Expr *Suggested = nullptr;
+  for (const Expr *E : Accesses) {
+    if (E->getType().getQualifiers().hasStrict())
+      continue;
+    if (isLocalAccess(E, A))
+      return;
+    if (!Suggested && isa<ArraySubscriptExpr>(E))
+      Suggested = E;
+  }
+  if (!Suggested)
+    return;
+
+  SmallString<256> Buf;
+  llvm::raw_svector_ostream OS(Buf);
+  OS << "The affinity expression '" << getSourceText(A)
+     << "' of this upc_forall does not match any shared access in the loop "
+        "body, so the accesses are remote; use '&"
+     << getSourceText(Suggested) << "' as the affinity expression";
+  report(Filter.checkName_UPCForallAffinity, "Mismatched upc_forall affinity",
+         OS.str(), A);
+}
+
+//===----------------------------------------------------------------------===//
+// Check: pointer-to-shared arithmetic that could be privatized.
+//===----------------------------------------------------------------------===//
+
+void WalkAST::checkPointerArith(const Expr *Ptr, const Expr *E) {
+  if (!Filter.check_UPCPrivatizablePointer || Loops.empty())
+    return;
+  const auto *DRE = dyn_cast<DeclRefExpr>(Ptr->IgnoreParenImpCasts());
+  if (!DRE || !isa<VarDecl>(DRE->getDecl()))
+    return;
+  const PointerType *PT = DRE->getType()->getAs<PointerType>();
+  if (!PT)
+    return;
+  // A pointer with an indefinite block size points to data on a single
+  // thread; if that is MYTHREAD, the pointer can be cast to a private
+  // pointer and the thread and phase updates disappear.
+  Qualifiers Q = PT->getPointeeType().getQualifiers();
+  if (Q.getLayoutQualifier() != 0 || !shouldReport(Ptr, CK_Pointer))
+    return;
+
+  SmallString<256> Buf;
+  llvm::raw_svector_ostream OS(Buf);
+  OS << "Pointer-to-shared arithmetic on '" << *DRE->getDecl()
+     << "' in a loop; all the data it points to is on one thread, so if "
+        "'upc_threadof("
+     << *DRE->getDecl()
+     << ") == MYTHREAD', cast it to a private pointer before the loop";
+  report(Filter.checkName_UPCPrivatizablePointer,
+         "Privatizable pointer-to-shared arithmetic", OS.str(), E);
+}
+
+//===----------------------------------------------------------------------===//
+// Check: bulk transfers with loop-dependent addresses.
+//===----------------------------------------------------------------------===//
+
+void WalkAST::checkTransfer(const CallExpr *CE) {
+  if (Loops.empty() || CE->getNumArgs() < 3)
+    return;
+  const FunctionDecl *FD = CE->getDirectCallee();
+  if (!FD || !FD->getIdentifier())
+    return;
+  StringRef Name = FD->getName();
+  bool IsTransfer =
+      llvm::StringSwitch<bool>(Name)
+          .Cases("upc_memcpy", "upc_memget", "upc_memput", true)
+          .Cases("upc_memcpyg", "upc_memgetg", "upc_memputg", true)
+          .Default(false);
+  if (!IsTransfer)
+    return;
+
+  // The loop variables are the variables changed by the loop increment.
+  const Stmt *Loop = Loops.back();
+  const Expr *Inc = nullptr;
+  if (const auto *FS = dyn_cast<ForStmt>(Loop))
+    Inc = FS->getInc();
+  else if (const auto *FAS = dyn_cast<UPCForAllStmt>(Loop))
+    Inc = FAS->getInc();
+  llvm::SmallPtrSet<const Decl *, 4> LoopVars;
+  collectVars(Inc, LoopVars);
+  if (LoopVars.empty() ||
+      !(refersTo(CE->getArg(0), LoopVars) || refersTo(CE->getArg(1), LoopVars)))
+    return;
+
+  SmallString<256> Buf;
+  llvm::raw_svector_ostream OS(Buf);
+  OS << "'" << Name
+     << "' is called once per iteration with addresses that depend on the "
+        "loop variable; if the addresses advance by a constant stride, "
+        "transfer the whole range with a single call, or gather the "
+        "elements with 'upc_gather_plan' and 'upc_gather_exec'";
+  report(Filter.checkName_UPCTransferInLoop, "Bulk transfer in a loop",
+         OS.str(), CE);
+}
+
+//===----------------------------------------------------------------------===//
+// UPCPerformanceChecker
+//===----------------------------------------------------------------------===//
+
+namespace {
+class UPCPerformanceChecker : public Checker<check::ASTCodeBody> {
+public:
+  ChecksFilter Filter;
+
+  void checkASTCodeBody(const Decl *D, AnalysisManager &Mgr,
+                        BugReporter &BR) const {
+    WalkAST Walker(BR, Mgr.getAnalysisDeclContext(D), Filter);
+    Walker.Visit(D->getBody());
+  }
+};
+} // end anonymous namespace
+
+void ento::registerUPCPerformanceChecker(CheckerManager &Mgr) {
+  Mgr.registerChecker<UPCPerformanceChecker>();
+}
+
+bool ento::shouldRegisterUPCPerformanceChecker(const LangOptions &LO) {
+  return LO.UPC;
+}
+
+#define REGISTER_CHECKER(name)                                                 \
+  void ento::register##name(CheckerManager &Mgr) {                             \
+    UPCPerformanceChecker *Checker = Mgr.getChecker<UPCPerformanceChecker>();  \
+    Checker->Filter.check_##name = true;                                       \
+    Checker->Filter.checkName_##name = Mgr.getCurrentCheckName();              \
+  }                                                                            \
+                                                                               \
+  bool ento::shouldRegister##name(const LangOptions &LO) { return LO.UPC; }
+
+REGISTER_CHECKER(UPCRemoteAccessInLoop)
+REGISTER_CHECKER(UPCForallAffinity)
+REGISTER_CHECKER(UPCStrictAccessInLoop)
+REGISTER_CHECKER(UPCTransferInLoop)
+REGISTER_CHECKER(UPCPrivatizablePointer)
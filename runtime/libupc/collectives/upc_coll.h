@@ -14,4 +14,19 @@
 extern int upc_coll_init_flag;
 extern void upc_coll_init (void);
 
+/* GASP collective events.  Only runtimes that provide the GASP
+   tool interface (GUPCR_HAVE_GASP) report them.  */
+#if GUPCR_HAVE_GASP
+#include <gasp_upc.h>
+extern void pupc_event_start (unsigned int evttag, ...);
+extern void pupc_event_end (unsigned int evttag, ...);
+#define upc_coll_event_start(evttag, ...) \
+  pupc_event_start (evttag, __VA_ARGS__)
+#define upc_coll_event_end(evttag, ...) \
+  pupc_event_end (evttag, __VA_ARGS__)
+#else
+#define upc_coll_event_start(evttag, ...)
+#define upc_coll_event_end(evttag, ...)
+#endif
+
 #endif /* !_UPC_COLL_H_ */
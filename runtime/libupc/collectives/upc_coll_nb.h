@@ -0,0 +1,50 @@
+/*===-- upc_coll_nb.h - UPC Runtime Support Library ----------------------===
+|*
+|*                     The LLVM Compiler Infrastructure
+|*
+|* Copyright 2012-2014, Intrepid Technology, Inc.  All rights reserved.
+|* This file is distributed under a BSD-style Open Source License.
+|* See LICENSE-INTREPID.TXT for details.
+|*
+|*===---------------------------------------------------------------------===*/
+
+#ifndef _UPC_COLL_NB_H_
+#define _UPC_COLL_NB_H_ 1
+
+#include <upc_collective.h>
+
+/* Non-blocking collective handles have the top bit set, which keeps
+   them apart from the runtime's own non-blocking transfer handles;
+   upc_sync and upc_sync_attempt pass them on to the functions below.  */
+#define UPC_COLL_NB_HANDLE_FLAG \
+  ((upc_handle_t) 1 << (sizeof (upc_handle_t) * 8 - 1))
+#define UPC_COLL_NB_IS_HANDLE(H) (((H) & UPC_COLL_NB_HANDLE_FLAG) != 0)
+extern int upc_coll_nb_sync_attempt (upc_handle_t handle);
+extern void upc_coll_nb_sync (upc_handle_t handle);
+
+/* Reduce function of a non-blocking (prefix) reduce,
+   converted to a type that does not depend on the element type.  */
+typedef void (*upc_coll_nb_func_t) (void);
+
+/* Reduce the 'nelems' elements at 'src', starting from the value
+   at 'init' if it is not NULL, and store the result at 'result',
+   which may be 'init'.  If 'dst' is not NULL, also store there the
+   reduction of each prefix of the elements.  */
+typedef void (*upc_coll_nb_combine_t) (void *result, void *dst,
+				       const void *src, size_t nelems,
+				       const void *init, upc_op_t op,
+				       upc_coll_nb_func_t func);
+
+/* Start a non-blocking reduce ('coll_op' is UPC_RED) or prefix
+   reduce (UPC_PRED) of elements of 'elem_size' bytes.  */
+extern upc_handle_t upc_coll_nb_reduce_start (shared void *dst,
+					      shared const void *src,
+					      upc_op_t op, size_t nelems,
+					      size_t blk_size,
+					      size_t elem_size,
+					      upc_coll_nb_func_t func,
+					      upc_coll_nb_combine_t combine,
+					      int coll_op,
+					      upc_flag_t sync_mode);
+
+#endif /* !_UPC_COLL_NB_H_ */
@@ -0,0 +1,59 @@
+/*===-- upc_team_sup.h - UPC Runtime Support Library ---------------------===
+|*
+|*                     The LLVM Compiler Infrastructure
+|*
+|* Copyright 2014, Intrepid Technology, Inc.  All rights reserved.
+|* This file is distributed under a BSD-style Open Source License.
+|* See LICENSE-INTREPID.TXT for details.
+|*
+|*===---------------------------------------------------------------------===*/
+
+#ifndef _UPC_TEAM_SUP_H_
+#define _UPC_TEAM_SUP_H_ 1
+
+#include <upc_team.h>
+
+/* Number of teams a thread can be a member of at the same time,
+   including the team of all threads.  Each team uses one of the
+   thread's team slots, and the same slot on all its members.  */
+#define UPC_TEAM_MAX_SLOTS 8
+
+struct upc_team_struct
+{
+  int rank;			/* Rank of the calling thread.  */
+  int size;			/* Number of members.  */
+  int *thread;			/* Thread of each rank (NULL: rank == thread).  */
+  int slot;			/* Team slot.  */
+  void *sup;			/* Runtime specific data.  */
+};
+
+/* Thread of the member of team 'T' with rank 'R'.  */
+#define UPC_TEAM_THREAD(T, R) ((T)->thread ? (T)->thread[R] : (R))
+
+/* Part of the team collective argument 'P' on 'THREAD'.  */
+#define UPC_TEAM_PART(P, THREAD) \
+  ((shared char *) (P) + ((int) (THREAD) \
+			  - (int) upc_threadof ((shared void *) (P))))
+
+/* Return TRUE if 'sync_mode' asks for IN (OUT) synchronization.  */
+#define UPC_TEAM_IN_SYNC(sync_mode) \
+  (UPC_IN_MYSYNC & (sync_mode) || !(UPC_IN_NOSYNC & (sync_mode)))
+#define UPC_TEAM_OUT_SYNC(sync_mode) \
+  (UPC_OUT_MYSYNC & (sync_mode) || !(UPC_OUT_NOSYNC & (sync_mode)))
+
+/* Return the rank of 'thread' in 'team' (fatal error if it is
+   not a member).  */
+extern int upc_team_rank_of (upc_team_t team, int thread);
+extern size_t upc_team_type_size (upc_type_t type);
+/* Combine the 'nelems' elements of 'type' in 'src' into 'dst'.  */
+extern void upc_team_combine (void *dst, const void *src, size_t nelems,
+			      upc_op_t op, upc_type_t type);
+extern void upc_team_error (const char *msg);
+
+/* Runtime specific team support.  upc_team_sup_init is called by
+   all members of a new team once its slot is chosen, before the
+   team is used; upc_team_sup_fini is called when it is freed.  */
+extern void upc_team_sup_init (upc_team_t team);
+extern void upc_team_sup_fini (upc_team_t team);
+
+#endif /* !_UPC_TEAM_SUP_H_ */
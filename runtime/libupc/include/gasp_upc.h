@@ -144,7 +144,7 @@ typedef enum
 #undef GASP_UPC_FENCE_SUPPORTED
 #undef GASP_UPC_NB_SUPPORTED
 #undef GASP_UPC_CACHE_SUPPORTED
-#undef GASP_UPC_ALL_SUPPORTED
+#define GASP_UPC_ALL_SUPPORTED 1
 
 #define GASP_UPC_EVT_NONE      0
 #define	GASP_C_FUNC	1
@@ -11,6 +11,7 @@
 #define _UPC_COLLECTIVE_H_
 
 #include <upc_types.h>
+#include <upc_nb.h>
 
 /* Per the UPC collectives library specification, the following
    operations are defined in addition to those defined in upc_types.h.
@@ -201,4 +202,165 @@ extern void upc_all_sort (shared void *A, size_t elem_size,
 			  int (*func) (shared void *, shared void *),
 			  upc_flag_t sync_mode);
 
+/* Non-blocking collectives.  Each returns a handle that must be
+   completed with upc_sync or upc_sync_attempt (see upc_nb.h).  All
+   threads must start the non-blocking collectives in the same order;
+   they may be completed in any order.  There is no background
+   progress: each thread moves its part of the data when it starts
+   a collective, waiting only for the data it needs, and only the
+   UPC_OUT_* synchronization is deferred until the collective is
+   completed.  */
+
+extern upc_handle_t
+upc_all_broadcast_nb (shared void *dst, shared const void *src, size_t nbytes,
+		      upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_scatter_nb (shared void *dst, shared const void *src, size_t nbytes,
+		    upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_gather_nb (shared void *dst, shared const void *src, size_t nbytes,
+		   upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_gather_all_nb (shared void *dst, shared const void *src, size_t nbytes,
+		       upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_exchange_nb (shared void *dst, shared const void *src, size_t nbytes,
+		     upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_reduceC_nb (shared void *dst, shared const void *src, upc_op_t op,
+		    size_t nelems, size_t blk_size,
+		    signed char (*func) (signed char, signed char),
+		    upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_reduceUC_nb (shared void *dst, shared const void *src, upc_op_t op,
+		     size_t nelems, size_t blk_size,
+		     unsigned char (*func) (unsigned char, unsigned char),
+		     upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_reduceS_nb (shared void *dst, shared const void *src, upc_op_t op,
+		    size_t nelems, size_t blk_size,
+		    signed short (*func) (signed short, signed short),
+		    upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_reduceUS_nb (shared void *dst, shared const void *src, upc_op_t op,
+		     size_t nelems, size_t blk_size,
+		     unsigned short (*func) (unsigned short, unsigned short),
+		     upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_reduceI_nb (shared void *dst, shared const void *src, upc_op_t op,
+		    size_t nelems, size_t blk_size,
+		    signed int (*func) (signed int, signed int),
+		    upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_reduceUI_nb (shared void *dst, shared const void *src, upc_op_t op,
+		     size_t nelems, size_t blk_size,
+		     unsigned int (*func) (unsigned int, unsigned int),
+		     upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_reduceL_nb (shared void *dst, shared const void *src, upc_op_t op,
+		    size_t nelems, size_t blk_size,
+		    signed long (*func) (signed long, signed long),
+		    upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_reduceUL_nb (shared void *dst, shared const void *src, upc_op_t op,
+		     size_t nelems, size_t blk_size,
+		     unsigned long (*func) (unsigned long, unsigned long),
+		     upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_reduceF_nb (shared void *dst, shared const void *src, upc_op_t op,
+		    size_t nelems, size_t blk_size,
+		    float (*func) (float, float), upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_reduceD_nb (shared void *dst, shared const void *src, upc_op_t op,
+		    size_t nelems, size_t blk_size,
+		    double (*func) (double, double), upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_reduceLD_nb (shared void *dst, shared const void *src, upc_op_t op,
+		     size_t nelems, size_t blk_size,
+		     long double (*func) (long double, long double),
+		     upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_prefix_reduceC_nb (shared void *dst, shared const void *src,
+			   upc_op_t op, size_t nelems, size_t blk_size,
+			   signed char (*func) (signed char, signed char),
+			   upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_prefix_reduceUC_nb (shared void *dst, shared const void *src,
+			    upc_op_t op, size_t nelems, size_t blk_size,
+			    unsigned char (*func) (unsigned char,
+						   unsigned char),
+			    upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_prefix_reduceS_nb (shared void *dst, shared const void *src,
+			   upc_op_t op, size_t nelems, size_t blk_size,
+			   signed short (*func) (signed short, signed short),
+			   upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_prefix_reduceUS_nb (shared void *dst, shared const void *src,
+			    upc_op_t op, size_t nelems, size_t blk_size,
+			    unsigned short (*func) (unsigned short,
+						    unsigned short),
+			    upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_prefix_reduceI_nb (shared void *dst, shared const void *src,
+			   upc_op_t op, size_t nelems, size_t blk_size,
+			   signed int (*func) (signed int, signed int),
+			   upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_prefix_reduceUI_nb (shared void *dst, shared const void *src,
+			    upc_op_t op, size_t nelems, size_t blk_size,
+			    unsigned int (*func) (unsigned int, unsigned int),
+			    upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_prefix_reduceL_nb (shared void *dst, shared const void *src,
+			   upc_op_t op, size_t nelems, size_t blk_size,
+			   signed long (*func) (signed long, signed long),
+			   upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_prefix_reduceUL_nb (shared void *dst, shared const void *src,
+			    upc_op_t op, size_t nelems, size_t blk_size,
+			    unsigned long (*func) (unsigned long,
+						   unsigned long),
+			    upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_prefix_reduceF_nb (shared void *dst, shared const void *src,
+			   upc_op_t op, size_t nelems, size_t blk_size,
+			   float (*func) (float, float), upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_prefix_reduceD_nb (shared void *dst, shared const void *src,
+			   upc_op_t op, size_t nelems, size_t blk_size,
+			   double (*func) (double, double),
+			   upc_flag_t sync_mode);
+
+extern upc_handle_t
+upc_all_prefix_reduceLD_nb (shared void *dst, shared const void *src,
+			    upc_op_t op, size_t nelems, size_t blk_size,
+			    long double (*func) (long double, long double),
+			    upc_flag_t sync_mode);
+
 #endif /* !_UPC_COLLECTIVE_H_ */
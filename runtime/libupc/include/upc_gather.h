@@ -0,0 +1,42 @@
+/*===-- upc_gather.h - UPC Runtime Support Library -----------------------===
+|*
+|*                     The LLVM Compiler Infrastructure
+|*
+|* Copyright 2014, Intrepid Technology, Inc.  All rights reserved.
+|* This file is distributed under a BSD-style Open Source License.
+|* See LICENSE-INTREPID.TXT for details.
+|*
+|*===---------------------------------------------------------------------===*/
+#ifndef _UPC_GATHER_H_
+#define _UPC_GATHER_H_
+
+#include <stddef.h>
+
+/* Inspector-executor gather of irregularly indexed elements of a
+   shared array, for loops such as 'x += a[idx[i]]'.
+
+   upc_gather_plan (the inspector) sorts and deduplicates the
+   indices by owner thread and merges nearby elements into ranges.
+   upc_gather_start (the executor) fetches each range with one
+   non-blocking transfer, and upc_gather_wait stores the elements
+   in index order in a local buffer.  A plan can be executed any
+   number of times while the array and indices stay the same.  */
+
+typedef struct upc_gather_struct *upc_gather_t;
+
+/* Plan the gather of elements 'idx'[0] .. 'idx'['n' - 1] of the
+   shared array 'base' of 'size' byte elements with 'blocksize'
+   elements per block (0: indefinite block size).  */
+extern upc_gather_t upc_gather_plan (shared const void *base,
+				     size_t blocksize, size_t size,
+				     const size_t *idx, size_t n);
+/* Start fetching the elements of 'plan'.  */
+extern void upc_gather_start (upc_gather_t plan);
+/* Wait for the elements of 'plan' and store element 'i' at
+   'dst' + 'i' * size.  */
+extern void upc_gather_wait (upc_gather_t plan, void *dst);
+/* upc_gather_start followed by upc_gather_wait.  */
+extern void upc_gather_exec (upc_gather_t plan, void *dst);
+extern void upc_gather_free (upc_gather_t plan);
+
+#endif /* !_UPC_GATHER_H_ */
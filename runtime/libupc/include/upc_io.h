@@ -0,0 +1,177 @@
+/*===-- upc_io.h - UPC Runtime Support Library ---------------------------===
+|*
+|*                     The LLVM Compiler Infrastructure
+|*
+|* Copyright 2014, Intrepid Technology, Inc.  All rights reserved.
+|* This file is distributed under a BSD-style Open Source License.
+|* See LICENSE-INTREPID.TXT for details.
+|*
+|*===---------------------------------------------------------------------===*/
+#ifndef _UPC_IO_H_
+#define _UPC_IO_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <upc_types.h>
+
+/* UPC parallel I/O (UPC-IO) library.  */
+
+typedef int64_t upc_off_t;
+
+/* UPC file handle.  */
+typedef shared struct upc_file_struct upc_file_t;
+
+struct upc_hint
+{
+  const char *key;
+  const char *value;
+};
+
+struct upc_local_memvec
+{
+  void *baseaddr;
+  size_t len;
+};
+
+struct upc_shared_memvec
+{
+  shared void *baseaddr;
+  size_t blocksize;		/* In bytes.  */
+  size_t len;
+};
+
+struct upc_filevec
+{
+  upc_off_t offset;
+  size_t len;
+};
+
+/* upc_all_fopen flags.  */
+#define UPC_RDONLY		(1<<0)
+#define UPC_WRONLY		(1<<1)
+#define UPC_RDWR		(1<<2)
+#define UPC_INDIVIDUAL_FP	(1<<3)
+#define UPC_COMMON_FP		(1<<4)
+#define UPC_APPEND		(1<<5)
+#define UPC_CREATE		(1<<6)
+#define UPC_EXCL		(1<<7)
+#define UPC_STRONG_CA		(1<<8)
+#define UPC_TRUNC		(1<<9)
+#define UPC_DELETE_ON_CLOSE	(1<<10)
+
+/* upc_all_fseek origins.  */
+#define UPC_SEEK_SET		0
+#define UPC_SEEK_CUR		1
+#define UPC_SEEK_END		2
+
+/* upc_all_fcntl commands.  */
+#define UPC_GET_CA_SEMANTICS		1
+#define UPC_SET_WEAK_CA_SEMANTICS	2
+#define UPC_SET_STRONG_CA_SEMANTICS	3
+#define UPC_GET_FP			4
+#define UPC_SET_COMMON_FP		5
+#define UPC_SET_INDIVIDUAL_FP		6
+#define UPC_GET_FN			7
+#define UPC_ASYNC_OUTSTANDING		8
+
+extern upc_file_t *
+upc_all_fopen (const char *fname, int flags, size_t numhints,
+	       struct upc_hint const *hints);
+extern int upc_all_fclose (upc_file_t *fd);
+extern int upc_all_fsync (upc_file_t *fd);
+extern upc_off_t upc_all_fseek (upc_file_t *fd, upc_off_t offset,
+				int origin);
+extern int upc_all_fset_size (upc_file_t *fd, upc_off_t size);
+extern upc_off_t upc_all_fget_size (upc_file_t *fd);
+extern int upc_all_fpreallocate (upc_file_t *fd, upc_off_t size);
+extern int upc_all_fcntl (upc_file_t *fd, int cmd, void *arg);
+
+extern upc_off_t
+upc_all_fread_local (upc_file_t *fd, void *buffer, size_t size,
+		     size_t nmemb, upc_flag_t sync_mode);
+extern upc_off_t
+upc_all_fwrite_local (upc_file_t *fd, void *buffer, size_t size,
+		      size_t nmemb, upc_flag_t sync_mode);
+extern upc_off_t
+upc_all_fread_shared (upc_file_t *fd, shared void *buffer,
+		      size_t blocksize, size_t size, size_t nmemb,
+		      upc_flag_t sync_mode);
+extern upc_off_t
+upc_all_fwrite_shared (upc_file_t *fd, shared void *buffer,
+		       size_t blocksize, size_t size, size_t nmemb,
+		       upc_flag_t sync_mode);
+
+/* List I/O.  The file pointers are not used or changed.  */
+extern upc_off_t
+upc_all_fread_list_local (upc_file_t *fd, size_t memvec_entries,
+			  struct upc_local_memvec const *memvec,
+			  size_t filevec_entries,
+			  struct upc_filevec const *filevec,
+			  upc_flag_t sync_mode);
+extern upc_off_t
+upc_all_fwrite_list_local (upc_file_t *fd, size_t memvec_entries,
+			   struct upc_local_memvec const *memvec,
+			   size_t filevec_entries,
+			   struct upc_filevec const *filevec,
+			   upc_flag_t sync_mode);
+extern upc_off_t
+upc_all_fread_list_shared (upc_file_t *fd, size_t memvec_entries,
+			   struct upc_shared_memvec const *memvec,
+			   size_t filevec_entries,
+			   struct upc_filevec const *filevec,
+			   upc_flag_t sync_mode);
+extern upc_off_t
+upc_all_fwrite_list_shared (upc_file_t *fd, size_t memvec_entries,
+			    struct upc_shared_memvec const *memvec,
+			    size_t filevec_entries,
+			    struct upc_filevec const *filevec,
+			    upc_flag_t sync_mode);
+
+/* Asynchronous I/O.  At most one asynchronous operation may be
+   outstanding on a file; its result is returned by
+   upc_all_fwait_async or upc_all_ftest_async.  This implementation
+   completes the operation before the call that starts it returns,
+   so it does not overlap computation; upc_all_ftest_async always
+   reports completion.  */
+extern void
+upc_all_fread_local_async (upc_file_t *fd, void *buffer, size_t size,
+			   size_t nmemb, upc_flag_t sync_mode);
+extern void
+upc_all_fwrite_local_async (upc_file_t *fd, void *buffer, size_t size,
+			    size_t nmemb, upc_flag_t sync_mode);
+extern void
+upc_all_fread_shared_async (upc_file_t *fd, shared void *buffer,
+			    size_t blocksize, size_t size, size_t nmemb,
+			    upc_flag_t sync_mode);
+extern void
+upc_all_fwrite_shared_async (upc_file_t *fd, shared void *buffer,
+			     size_t blocksize, size_t size, size_t nmemb,
+			     upc_flag_t sync_mode);
+extern void
+upc_all_fread_list_local_async (upc_file_t *fd, size_t memvec_entries,
+				struct upc_local_memvec const *memvec,
+				size_t filevec_entries,
+				struct upc_filevec const *filevec,
+				upc_flag_t sync_mode);
+extern void
+upc_all_fwrite_list_local_async (upc_file_t *fd, size_t memvec_entries,
+				 struct upc_local_memvec const *memvec,
+				 size_t filevec_entries,
+				 struct upc_filevec const *filevec,
+				 upc_flag_t sync_mode);
+extern void
+upc_all_fread_list_shared_async (upc_file_t *fd, size_t memvec_entries,
+				 struct upc_shared_memvec const *memvec,
+				 size_t filevec_entries,
+				 struct upc_filevec const *filevec,
+				 upc_flag_t sync_mode);
+extern void
+upc_all_fwrite_list_shared_async (upc_file_t *fd, size_t memvec_entries,
+				  struct upc_shared_memvec const *memvec,
+				  size_t filevec_entries,
+				  struct upc_filevec const *filevec,
+				  upc_flag_t sync_mode);
+extern upc_off_t upc_all_fwait_async (upc_file_t *fd);
+extern upc_off_t upc_all_ftest_async (upc_file_t *fd, int *flag);
+
+#endif /* !_UPC_IO_H_ */
@@ -0,0 +1,52 @@
+/*===-- upc_task.h - UPC Runtime Support Library -------------------------===
+|*
+|*                     The LLVM Compiler Infrastructure
+|*
+|* Copyright 2014, Intrepid Technology, Inc.  All rights reserved.
+|* This file is distributed under a BSD-style Open Source License.
+|* See LICENSE-INTREPID.TXT for details.
+|*
+|*===---------------------------------------------------------------------===*/
+#ifndef _UPC_TASK_H_
+#define _UPC_TASK_H_
+
+#include <stddef.h>
+
+/* Dynamically load balanced task pools.
+
+   Each thread has a deque of fixed size tasks in shared memory.
+   A thread pushes and pops tasks at the local end of its own deque
+   without atomic operations, and periodically makes the oldest of
+   them available for stealing.  Threads that run out of work steal
+   half of the available tasks of another thread, trying the threads
+   whose memory they can access directly first.  Tasks are plain
+   data: they are copied between threads, so they must not contain
+   pointers to private memory.  */
+
+typedef shared struct upc_taskpool_struct upc_taskpool_t;
+
+/* Run the task 'task' of 'pool'.  'arg' is the argument passed to
+   upc_all_taskpool_run.  The function may push new tasks.  */
+typedef void (*upc_task_fn_t) (upc_taskpool_t *pool, void *task, void *arg);
+
+/* Allocate a pool of tasks of 'task_size' bytes, with room for
+   'capacity' tasks in the deque of each thread (collective).  */
+extern upc_taskpool_t *upc_all_taskpool_alloc (size_t task_size,
+					       size_t capacity);
+extern void upc_all_taskpool_free (upc_taskpool_t *pool);
+
+/* Push a copy of 'task' to the calling thread's deque.  */
+extern void upc_taskpool_push (upc_taskpool_t *pool, const void *task);
+/* Pop the most recently pushed task of the calling thread's deque
+   into 'task'.  Return 0 if the deque is empty.  */
+extern int upc_taskpool_pop (upc_taskpool_t *pool, void *task);
+/* Steal a task from another thread into 'task'.  Return 0 if no
+   task could be stolen.  */
+extern int upc_taskpool_steal (upc_taskpool_t *pool, void *task);
+
+/* Run the tasks of 'pool' with 'fn' until all the deques are empty
+   and no thread runs a task (collective).  */
+extern void upc_all_taskpool_run (upc_taskpool_t *pool, upc_task_fn_t fn,
+				  void *arg);
+
+#endif /* !_UPC_TASK_H_ */
@@ -0,0 +1,87 @@
+/*===-- upc_team.h - UPC Runtime Support Library -------------------------===
+|*
+|*                     The LLVM Compiler Infrastructure
+|*
+|* Copyright 2014, Intrepid Technology, Inc.  All rights reserved.
+|* This file is distributed under a BSD-style Open Source License.
+|* See LICENSE-INTREPID.TXT for details.
+|*
+|*===---------------------------------------------------------------------===*/
+#ifndef _UPC_TEAM_H_
+#define _UPC_TEAM_H_
+
+#include <upc_types.h>
+
+/* UPC thread team.  A team is an ordered subset of the threads;
+   each member has a rank between 0 and the size of the team - 1.
+   Team handles are local to the calling thread.  */
+typedef struct upc_team_struct *upc_team_t;
+
+#define UPC_TEAM_NULL ((upc_team_t) 0)
+
+/* Color of the threads that do not join any new team.  */
+#define UPC_TEAM_NOCOLOR (-1)
+
+/* Team of all threads.  */
+extern upc_team_t upc_team_all (void);
+
+/* Split 'team' into new teams, one per color.  The members of each
+   new team are ranked by 'key', then by their rank in 'team'.
+   Collective over 'team'.  Return UPC_TEAM_NULL for the threads
+   with color UPC_TEAM_NOCOLOR.  */
+extern upc_team_t upc_team_split (upc_team_t team, int color, int key);
+
+/* Split 'team' into the teams of the threads that share memory.  */
+extern upc_team_t upc_team_split_node (upc_team_t team);
+
+/* View the members of 'team' as a grid of 'ncols' columns, in rank
+   order, and return the team of the calling thread's row in '*row'
+   and of its column in '*col'.  */
+extern void upc_team_split_grid (upc_team_t team, int ncols,
+				 upc_team_t *row, upc_team_t *col);
+
+/* Release 'team'.  Collective over 'team'.  */
+extern void upc_team_free (upc_team_t team);
+
+extern int upc_team_rank (upc_team_t team);
+extern int upc_team_size (upc_team_t team);
+
+/* Return the thread number of the member of 'team' with rank 'rank'.  */
+extern int upc_team_thread (upc_team_t team, int rank);
+
+/* Team collectives.  Each member's part of 'src' and 'dst' is at the
+   same local address as 'src' ('dst') on the member's thread.  The
+   sync_mode flags have the same meaning as for the upc_all_*
+   collectives, but only synchronize the members of the team.  */
+
+extern void upc_team_barrier (upc_team_t team);
+
+/* Copy 'nbytes' bytes from 'src' to the 'dst' part of each member.  */
+extern void upc_team_broadcast (upc_team_t team, shared void *dst,
+				shared const void *src, size_t nbytes,
+				upc_flag_t sync_mode);
+
+/* Reduce, element by element, the 'nelems' elements of 'type' in the
+   'src' parts of all members into 'dst'.  The order in which the parts
+   are combined is unspecified, so floating-point results may differ
+   between runs and runtimes.  The 'dst' part of the other members is
+   used as workspace.  */
+extern void upc_team_reduce (upc_team_t team, shared void *dst,
+			     shared const void *src, upc_op_t op,
+			     upc_type_t type, size_t nelems,
+			     upc_flag_t sync_mode);
+
+/* Like upc_team_reduce, but store the result in the 'dst' part
+   of each member.  */
+extern void upc_team_allreduce (upc_team_t team, shared void *dst,
+				shared const void *src, upc_op_t op,
+				upc_type_t type, size_t nelems,
+				upc_flag_t sync_mode);
+
+/* Concatenate the 'nbytes' bytes of the 'src' part of each member,
+   in rank order, into the 'dst' part of each member.  */
+extern void upc_team_allgather (upc_team_t team, shared void *dst,
+				shared const void *src, size_t nbytes,
+				upc_flag_t sync_mode);
+
+#endif /* !_UPC_TEAM_H_ */
@@ -30,6 +30,11 @@
  * the one used to implement a barrier.  The "up phase" signals
  * that each thread is ready to receive the broadcast value, while the
  * "down phase" is used to receive the actual value.
+ *
+ * Values larger than GUPCR_MAX_BROADCAST_SIZE are sent as a sequence
+ * of broadcasts of at most GUPCR_MAX_BROADCAST_SIZE bytes each.
+ * Large user level broadcasts should use upc_all_broadcast, which
+ * pipelines the data through the collectives tree.
  */
 
 /**
@@ -52,12 +57,14 @@ gupcr_broadcast_get (void *value, size_t nbytes)
   GUPCR_OMP_CHECK();
   if (!MYTHREAD)
     gupcr_fatal_error ("called from thread 0");
-  if (nbytes > GUPCR_MAX_BROADCAST_SIZE)
-    gupcr_fatal_error ("size of broadcast message (%ld) is greater then "
-		       "the maximum allowed (%d)",
-		       (long int) nbytes, GUPCR_MAX_BROADCAST_SIZE);
   /* Wait to receive the broadcast message.  */
-  gupcr_bcast_recv (value, nbytes);
+  while (nbytes)
+    {
+      size_t n_xfer = GUPCR_MIN (nbytes, (size_t) GUPCR_MAX_BROADCAST_SIZE);
+      gupcr_bcast_recv (value, n_xfer);
+      value = (char *) value + n_xfer;
+      nbytes -= n_xfer;
+    }
 }
 
 /**
@@ -77,12 +84,14 @@ gupcr_broadcast_put (void *value, size_t nbytes)
     return;
   if (MYTHREAD)
     gupcr_fatal_error ("called from thread other then 0");
-  if (nbytes > GUPCR_MAX_BROADCAST_SIZE)
-    gupcr_fatal_error ("size of broadcast message (%ld) is greater then "
-		       "maximum allowed (%d)",
-		       (long int) nbytes, GUPCR_MAX_BROADCAST_SIZE);
   /* Send the broadcast message to the children of the root thread.  */
-  gupcr_bcast_send (value, nbytes);
+  while (nbytes)
+    {
+      size_t n_xfer = GUPCR_MIN (nbytes, (size_t) GUPCR_MAX_BROADCAST_SIZE);
+      gupcr_bcast_send (value, n_xfer);
+      value = (char *) value + n_xfer;
+      nbytes -= n_xfer;
+    }
 }
 
 /**
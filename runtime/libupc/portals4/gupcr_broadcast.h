@@ -21,7 +21,7 @@
  * @{
  */
 
-/** Maximum message size that can be sent via broadcast.  */
+/** Maximum message size that can be sent in a single broadcast step.  */
 #define GUPCR_MAX_BROADCAST_SIZE 32
 
 /** @} */
@@ -53,8 +53,16 @@ int gupcr_coll_child_index;
 /** Collectives tree children threads */
 int gupcr_coll_child[GUPCR_TREE_FANOUT];
 
+/** Collectives tree fanout (see UPC_COLL_FANOUT) */
+static int gupcr_coll_fanout;
+
+/** Collectives tree cache, indexed by a hash of (root, start, nthreads) */
+static gupcr_coll_tree_t gupcr_coll_tree_cache[GUPCR_COLL_TREE_CACHE_SIZE];
+/** Tree currently loaded into the gupcr_coll_* tree variables */
+static gupcr_coll_tree_ref gupcr_coll_tree_current;
+
 /**
- * Initialize collectives thread tree.
+ * Calculate a collectives thread tree.
  *
  * A collectives tree starts from the "start" thread number and
  * includes only "nthreads" (e.g. threads involved in
@@ -66,13 +74,14 @@ int gupcr_coll_child[GUPCR_TREE_FANOUT];
  * form where the "newroot" value identitifies
  * the root thread (only if the "newroot" thread
  * is participating in the operation).
+ * @param [out] tree Tree descriptor
  * @param [in] newroot A hint for the tree root thread.
  * @param [in] start Start thread for reduce
  * @param [in] nthreads Number of threads participating
- *
  */
-void
-gupcr_coll_tree_setup (size_t newroot, size_t start, int nthreads)
+static void
+gupcr_coll_tree_calc (gupcr_coll_tree_ref tree,
+		      size_t newroot, size_t start, int nthreads)
 {
 /* Convert from/to 0-(THREADS-1) to start-(nthreads-1) range.  */
 #define NEWID(id,first) ((id - first + THREADS) % THREADS)
@@ -81,13 +90,21 @@ gupcr_coll_tree_setup (size_t newroot, size_t start, int nthreads)
 /* Remap into the new root (from root 0 to "root").  */
 #define NEWIDROOT(id,top,cnt) ((cnt + id - top) % cnt)
 #define OLDIDROOT(nid,top,cnt) ((nid + top) % cnt)
+  const int fanout = gupcr_coll_fanout;
   int i;
   int ok_to_root = 0;
   int myid;
   int root = NEWID (newroot, start);
 
-  gupcr_debug (FC_COLL, "newroot: %lu, start: %lu nthreads: %d",
-	       (long unsigned) newroot, (long unsigned) start, nthreads);
+  gupcr_debug (FC_COLL, "newroot: %lu, start: %lu nthreads: %d fanout: %d",
+	       (long unsigned) newroot, (long unsigned) start, nthreads,
+	       fanout);
+
+  tree->valid = 1;
+  tree->root = newroot;
+  tree->start = start;
+  tree->nthreads = nthreads;
+  tree->child_index = 0;
 
   /* Check if root node is participating.  If yes, use that for the
      root, otherwise 0.  */
@@ -101,30 +118,112 @@ gupcr_coll_tree_setup (size_t newroot, size_t start, int nthreads)
     myid = NEWIDROOT (myid, root, nthreads);
 
   /* Calculate the thread id's of the children and parent.  */
-  gupcr_coll_child_cnt = 0;
-  for (i = 0; i < GUPCR_TREE_FANOUT; i++)
+  tree->child_cnt = 0;
+  for (i = 0; i < fanout; i++)
     {
-      int child = (GUPCR_TREE_FANOUT * myid + i + 1);
+      int child = (fanout * myid + i + 1);
       if (child < nthreads)
 	{
-	  ++gupcr_coll_child_cnt;
+	  ++tree->child_cnt;
 	  if (ok_to_root)
 	    child = OLDIDROOT (child, root, nthreads);
-	  gupcr_coll_child[i] = OLDID (child, start);
+	  tree->child[i] = OLDID (child, start);
 	}
     }
   if (myid)
     {
-      gupcr_coll_parent_thread = (myid - 1) / GUPCR_TREE_FANOUT;
-      gupcr_coll_child_index =
-	myid - gupcr_coll_parent_thread * GUPCR_TREE_FANOUT - 1;
+      tree->parent_thread = (myid - 1) / fanout;
+      tree->child_index = myid - tree->parent_thread * fanout - 1;
       if (ok_to_root)
-	gupcr_coll_parent_thread =
-	  OLDIDROOT (gupcr_coll_parent_thread, root, nthreads);
-      gupcr_coll_parent_thread = OLDID (gupcr_coll_parent_thread, start);
+	tree->parent_thread =
+	  OLDIDROOT (tree->parent_thread, root, nthreads);
+      tree->parent_thread = OLDID (tree->parent_thread, start);
     }
   else
-    gupcr_coll_parent_thread = ROOT_PARENT;
+    tree->parent_thread = ROOT_PARENT;
+}
+
+/**
+ * Calculate a collectives tree of team ranks.
+ *
+ * The tree has the same shape as the one calculated by
+ * gupcr_coll_tree_calc for the "nranks" threads starting at 0,
+ * but is expressed in team ranks: the parent and children fields
+ * of the tree descriptor are ranks in the range 0-(nranks-1).
+ *
+ * @param [out] tree Tree descriptor
+ * @param [in] root Rank of the tree root
+ * @param [in] rank Rank of the calling thread
+ * @param [in] nranks Number of ranks
+ */
+void
+gupcr_coll_tree_rank_calc (gupcr_coll_tree_ref tree,
+			   int root, int rank, int nranks)
+{
+  const int fanout = gupcr_coll_fanout;
+  const int myid = NEWIDROOT (rank, root, nranks);
+  int i;
+
+  tree->valid = 1;
+  tree->root = root;
+  tree->start = 0;
+  tree->nthreads = nranks;
+  tree->child_index = 0;
+  tree->child_cnt = 0;
+  for (i = 0; i < fanout; i++)
+    {
+      int child = (fanout * myid + i + 1);
+      if (child < nranks)
+	{
+	  ++tree->child_cnt;
+	  tree->child[i] = OLDIDROOT (child, root, nranks);
+	}
+    }
+  if (myid)
+    {
+      int parent = (myid - 1) / fanout;
+      tree->child_index = myid - parent * fanout - 1;
+      tree->parent_thread = OLDIDROOT (parent, root, nranks);
+    }
+  else
+    tree->parent_thread = ROOT_PARENT;
+}
+
+/**
+ * Initialize collectives thread tree.
+ *
+ * The tree for a given (newroot, start, nthreads) triple does not
+ * change over the life of the program, so it is calculated once,
+ * saved in a small direct mapped cache, and copied into
+ * the gupcr_coll_* tree variables on later calls.
+ * The tree calculation is described in gupcr_coll_tree_calc.
+ *
+ * @param [in] newroot A hint for the tree root thread.
+ * @param [in] start Start thread for reduce
+ * @param [in] nthreads Number of threads participating
+ */
+void
+gupcr_coll_tree_setup (size_t newroot, size_t start, int nthreads)
+{
+  gupcr_coll_tree_ref tree;
+  size_t slot;
+
+  tree = gupcr_coll_tree_current;
+  if (tree && tree->root == newroot && tree->start == start
+      && tree->nthreads == nthreads)
+    return;
+  slot = (newroot * 31 + start * 7 + (size_t) nthreads)
+	 % GUPCR_COLL_TREE_CACHE_SIZE;
+  tree = &gupcr_coll_tree_cache[slot];
+  if (!(tree->valid && tree->root == newroot && tree->start == start
+	&& tree->nthreads == nthreads))
+    gupcr_coll_tree_calc (tree, newroot, start, nthreads);
+  gupcr_coll_parent_thread = tree->parent_thread;
+  gupcr_coll_child_cnt = tree->child_cnt;
+  gupcr_coll_child_index = tree->child_index;
+  memcpy (gupcr_coll_child, tree->child,
+	  tree->child_cnt * sizeof (gupcr_coll_child[0]));
+  gupcr_coll_tree_current = tree;
 }
 
 /**
@@ -353,6 +452,11 @@ gupcr_coll_init (void)
   /* Reset the number of signals/acks.  */
   gupcr_coll_signal_cnt = 0;
   gupcr_coll_ack_cnt = 0;
+
+  /* Invalidate the collectives tree cache.  */
+  gupcr_coll_fanout = gupcr_get_coll_fanout ();
+  memset (gupcr_coll_tree_cache, 0, sizeof (gupcr_coll_tree_cache));
+  gupcr_coll_tree_current = NULL;
 }
 
 /**
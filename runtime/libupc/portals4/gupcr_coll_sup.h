@@ -64,10 +64,26 @@ extern int gupcr_coll_child_cnt;
 extern int gupcr_coll_child_index;
 extern int gupcr_coll_child[GUPCR_TREE_FANOUT];
 
+/** Collectives tree descriptor, as cached by gupcr_coll_tree_setup.  */
+typedef struct gupcr_coll_tree_struct
+{
+  int valid;
+  size_t root;
+  size_t start;
+  int nthreads;
+  int parent_thread;
+  int child_cnt;
+  int child_index;
+  int child[GUPCR_TREE_FANOUT];
+} gupcr_coll_tree_t;
+typedef gupcr_coll_tree_t *gupcr_coll_tree_ref;
+
 /** Check if thread is the root thread by checking its parent.  */
 #define IS_ROOT_THREAD (gupcr_coll_parent_thread == ROOT_PARENT)
 
 void gupcr_coll_tree_setup (size_t newroot, size_t start, int nthreads);
+void gupcr_coll_tree_rank_calc (gupcr_coll_tree_ref tree,
+				int root, int rank, int nranks);
 void gupcr_coll_put (size_t dthread,
 		     size_t doffset, size_t soffset, size_t nbytes);
 void gupcr_coll_trigput (size_t dthread,
@@ -84,6 +100,8 @@ void gupcr_coll_signal_wait (size_t cnt);
 
 void gupcr_coll_init (void);
 void gupcr_coll_fini (void);
+void gupcr_team_init (void);
+void gupcr_team_fini (void);
 
 /** @} */
 
@@ -51,6 +51,20 @@
 
 #include "config.h"
 
+//begin lib_release_config
+/* The release library variant (and user code compiled with
+   -fupc-release-lib) leaves out runtime checks, debugging,
+   statistics and tracing, including the OpenMP thread checks
+   made on entry to each runtime call.  */
+#if defined (GUPCR_RELEASE_LIB) || defined (__UPC_RELEASE_LIB__)
+#undef GUPCR_HAVE_CHECKS
+#undef GUPCR_HAVE_DEBUG
+#undef GUPCR_HAVE_STATS
+#undef GUPCR_HAVE_TRACE
+#undef GUPCR_HAVE_OMP_CHECKS
+#endif
+//end lib_release_config
+
 #define DEV_ZERO "/dev/zero"
 #define OFFSET_ZERO ((off_t) 0)
 /* Darwin has MAP_ANON defined for anonymous memory map.  */
@@ -136,6 +150,38 @@ typedef unsigned int u_intTI_t __attribute__ ((__mode__ (__TI__)));
 
 //end lib_config_heap
 
+/** Local heap blocks (including the heap management header)
+    up to this size are served from thread-private size class
+    free lists.  Classes are spaced by GUPCR_HEAP_ALLOC_OVERHEAD
+    bytes up to GUPCR_HEAP_LOCAL_LINEAR_MAX, and then four per
+    power of 2.  Larger blocks are allocated from the local heap's
+    free extents list.  */
+#define GUPCR_HEAP_LOCAL_MAX_CLASS_SIZE (32*KILOBYTE)
+
+/** Largest local heap size class spaced linearly (1 kilobyte).  */
+#define GUPCR_HEAP_LOCAL_LINEAR_MAX_BITS 10
+#define GUPCR_HEAP_LOCAL_LINEAR_MAX (1 << GUPCR_HEAP_LOCAL_LINEAR_MAX_BITS)
+
+/** Number of linearly spaced local heap size classes.  */
+#define GUPCR_HEAP_LOCAL_LINEAR_CLASSES \
+  (GUPCR_HEAP_LOCAL_LINEAR_MAX / GUPCR_HEAP_ALLOC_OVERHEAD - 1)
+
+/** Number of local heap size classes.  */
+#define GUPCR_HEAP_LOCAL_NUM_CLASSES (GUPCR_HEAP_LOCAL_LINEAR_CLASSES + 4 * 5)
+
+/** Size of the local heap chunks carved into size class blocks,
+    and the granularity of local heap growth.  */
+#define GUPCR_HEAP_LOCAL_CHUNK_SIZE (256*KILOBYTE)
+
+/** Default size of a pipelined collectives segment (64 kilobytes).  */
+#define GUPCR_COLL_DEFAULT_SEGMENT_SIZE C64K
+
+/** Maximum segment size accepted by UPC_COLL_SEGMENT_SIZE.  */
+#define GUPCR_COLL_MAX_SEGMENT_SIZE (64L * MEGABYTE)
+
+/** Number of entries in the collectives tree cache.  */
+#define GUPCR_COLL_TREE_CACHE_SIZE 16
+
 /*
  * Main entry for UPC programs.
  * The runtime will execute before calling the user's main
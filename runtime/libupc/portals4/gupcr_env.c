@@ -20,6 +20,17 @@
 
 /**
 
+ UPC_COLL_FANOUT
+
+	If set, specifies the number of children of each thread in the
+	tree used by the collectives (at most the configured
+	GUPCR_TREE_FANOUT).
+
+ UPC_COLL_SEGMENT_SIZE
+
+	If set, specifies the size of the segments that are pipelined
+	down the collectives tree by upc_all_broadcast.
+
  UPC_DEBUG
 
 	If set, specifies a list of "facilities" that
@@ -142,6 +153,8 @@ typedef enum
 {
   ENV_NONE = 0,
   ENV_UPC_BACKTRACE,
+  ENV_UPC_COLL_FANOUT,
+  ENV_UPC_COLL_SEGMENT_SIZE,
   ENV_UPC_DEBUG,
   ENV_UPC_DEBUGFILE,
   ENV_UPC_FIRSTTOUCH,
@@ -169,6 +182,8 @@ static const struct gupcr_env_var_struct
 gupcr_env_var_table[] =
 {
   {"UPC_BACKTRACE", ENV_UPC_BACKTRACE},
+  {"UPC_COLL_FANOUT", ENV_UPC_COLL_FANOUT},
+  {"UPC_COLL_SEGMENT_SIZE", ENV_UPC_COLL_SEGMENT_SIZE},
   {"UPC_DEBUG", ENV_UPC_DEBUG},
   {"UPC_DEBUGFILE", ENV_UPC_DEBUGFILE},
   {"UPC_FIRSTTOUCH", ENV_UPC_FIRSTTOUCH},
@@ -402,6 +417,14 @@ gupcr_env_init (void)
 	    case ENV_UPC_BACKTRACE:
 	      gupcr_set_backtrace (gupcr_env_boolean (env_var));
 	      break;
+	    case ENV_UPC_COLL_FANOUT:
+	      gupcr_set_coll_fanout ((int) gupcr_env_size (env_var,
+							   GUPCR_TREE_FANOUT));
+	      break;
+	    case ENV_UPC_COLL_SEGMENT_SIZE:
+	      gupcr_set_coll_segment_size ((size_t) gupcr_env_size (env_var,
+					   GUPCR_COLL_MAX_SEGMENT_SIZE));
+	      break;
 	    case ENV_UPC_DEBUG:
 	      facility_mask = gupcr_env_facility_list (env_var);
 	      if (facility_mask)
@@ -54,6 +54,41 @@ size_t gupcr_gmem_put_bb_used;
 /** Previous operation was a strict put */
 int gupcr_pending_strict_put;
 
+#if GUPCR_USE_PORTALS4_TRIGGERED_OPS
+/** Remote to remote copy staging buffer (slot).
+ *
+ *  Each slot has its own GET and PUT memory descriptors and counting
+ *  events, so that the PUT of the data staged in the slot can be
+ *  triggered by the completion of the GET into the slot, and the slot
+ *  can be reused when that PUT completes, regardless of the order in
+ *  which the transfers of other slots complete.
+ */
+typedef struct gupcr_gmem_copy_slot_struct
+{
+  /** Staging buffer */
+  char buf[GUPCR_GMEM_COPY_SLOT_SIZE];
+  /** GET memory descriptor handle */
+  ptl_handle_md_t get_md;
+  /** GET counting events handle */
+  ptl_handle_ct_t get_ct;
+  /** PUT memory descriptor handle */
+  ptl_handle_md_t put_md;
+  /** PUT counting events handle */
+  ptl_handle_ct_t put_ct;
+  /** Number of copies staged through this slot */
+  ptl_size_t num_initiated;
+  /** Number of copies through this slot known to be complete */
+  ptl_size_t num_completed;
+} gupcr_gmem_copy_slot_t;
+
+/** Remote to remote copy staging buffers */
+static gupcr_gmem_copy_slot_t gupcr_gmem_copy_slots[GUPCR_GMEM_COPY_SLOTS];
+/** Next staging buffer to use */
+static int gupcr_gmem_copy_next_slot;
+/** Remote to remote copy PUTs may be outstanding */
+static int gupcr_gmem_copy_pending;
+#endif /* GUPCR_USE_PORTALS4_TRIGGERED_OPS */
+
 /** Heap base offset relative to start of UPC shared region */
 size_t gupcr_gmem_heap_base_offset;
 
@@ -118,6 +153,72 @@ gupcr_gmem_sync_gets (void)
     }
 }
 
+#if GUPCR_USE_PORTALS4_TRIGGERED_OPS
+/**
+ * Wait for the completion of the copy staged in a copy slot.
+ *
+ * The GET into the slot is checked first, so that its failure
+ * is reported as such.  The triggered PUT of the slot is
+ * performed even if the GET fails, because the trigger
+ * threshold counts failed operations too; the program is
+ * aborted in either case.
+ *
+ * @param [in] slot Copy staging buffer
+ */
+static void
+gupcr_gmem_copy_slot_wait (gupcr_gmem_copy_slot_t *slot)
+{
+  ptl_ct_event_t ct;
+  if (slot->num_completed == slot->num_initiated)
+    return;
+  gupcr_portals_call (PtlCTWait,
+		      (slot->get_ct, slot->num_initiated, &ct));
+  if (ct.failure > 0)
+    {
+      gupcr_process_fail_events (gupcr_gmem_gets.eq_handle);
+      gupcr_abort ();
+    }
+  gupcr_portals_call (PtlCTWait,
+		      (slot->put_ct, slot->num_initiated, &ct));
+  if (ct.failure > 0)
+    {
+      gupcr_process_fail_events (gupcr_gmem_puts.eq_handle);
+      gupcr_abort ();
+    }
+  slot->num_completed = slot->num_initiated;
+}
+
+/**
+ * Complete outstanding remote to remote copies.
+ */
+static void
+gupcr_gmem_copy_sync (void)
+{
+  int i;
+  for (i = 0; i < GUPCR_GMEM_COPY_SLOTS; ++i)
+    gupcr_gmem_copy_slot_wait (&gupcr_gmem_copy_slots[i]);
+  gupcr_gmem_copy_pending = 0;
+}
+#endif /* GUPCR_USE_PORTALS4_TRIGGERED_OPS */
+
+/**
+ * Complete outstanding remote to remote copies, if any.
+ *
+ * The PUTs of a copy are triggered by the completion of the GETs
+ * into the copy staging buffers, so they are not ordered with the
+ * accesses issued after the copy.  Those accesses call this
+ * function first, to preserve the order of the accesses of
+ * a thread to the same location.
+ */
+static inline void
+gupcr_gmem_copy_order (void)
+{
+#if GUPCR_USE_PORTALS4_TRIGGERED_OPS
+  if (gupcr_gmem_copy_pending)
+    gupcr_gmem_copy_sync ();
+#endif
+}
+
 /**
  * Complete outstanding remote PUT operations.
  *
@@ -131,6 +232,8 @@ gupcr_gmem_sync_puts (void)
 {
   /* Sync all outstanding local accesses.  */
   GUPCR_MEM_BARRIER ();
+  /* Sync all outstanding remote to remote copies.  */
+  gupcr_gmem_copy_order ();
   /* Sync all outstanding remote put accesses.  */
   if (gupcr_gmem_puts.num_pending > 0)
     {
@@ -187,6 +290,7 @@ gupcr_gmem_get (void *dest, int thread, size_t offset, size_t n)
 
   gupcr_debug (FC_MEM, "%d:0x%lx 0x%lx",
 	       thread, (long unsigned) offset, (long unsigned) dest);
+  gupcr_gmem_copy_order ();
   rpid.rank = thread;
   while (n_rem > 0)
     {
@@ -227,6 +331,7 @@ gupcr_gmem_put (int thread, size_t offset, const void *src, size_t n)
   ptl_process_t rpid;
   gupcr_debug (FC_MEM, "0x%lx %d:0x%lx",
                        (long unsigned) src, thread, (long unsigned) offset);
+  gupcr_gmem_copy_order ();
   rpid.rank = thread;
   /* Large puts must be synchronous, to ensure that it is
      safe to re-use the source buffer upon return.  */
@@ -295,10 +400,22 @@ gupcr_gmem_put (int thread, size_t offset, const void *src, size_t n)
  * Copy remote shared memory from the source thread
  * to the destination thread.
  *
- * Bulk copy from one thread to another.
- * The put bounce buffer is used as an intermediate buffer.
+ * Bulk copy from one thread to another.  With triggered
+ * operations, the data is staged in chunks through the copy
+ * staging buffers (slots), used in turn.  For each chunk, a GET
+ * from the source thread into a slot is issued together with
+ * a PUT from that slot to the destination thread, triggered by
+ * the completion of the GET.  Thus the GET of one chunk overlaps
+ * the PUT of the previous ones, and the caller only waits when
+ * it needs to reuse a slot whose PUT has not completed yet.
+ * The last PUTs are completed by the next access, or by
+ * gupcr_gmem_sync_puts ().  Otherwise, the put bounce buffer
+ * is used as an intermediate buffer.
+ *
  * Caller assumes responsibility for checking the validity
- * of the remote thread id's and/or shared memory offsets.
+ * of the remote thread id's and/or shared memory offsets, and
+ * accesses the shared memory of node local threads directly
+ * (through gupcr_node_map) instead of calling this function.
  *
  * @param [in] dthread Destination thread
  * @param [in] doffset Destination offset
@@ -310,6 +427,11 @@ void
 gupcr_gmem_copy (int dthread, size_t doffset,
 		 int sthread, size_t soffset, size_t n)
 {
+#if GUPCR_USE_PORTALS4_TRIGGERED_OPS
+  const size_t chunk_size = GUPCR_MIN ((size_t) GUPCR_GMEM_COPY_SLOT_SIZE,
+				      (size_t) GUPCR_MAX_MSG_SIZE);
+  ptl_process_t spid;
+#endif
   size_t n_rem = n;
   ptl_size_t dest_addr = doffset;
   ptl_size_t src_addr = soffset;
@@ -319,6 +441,38 @@ gupcr_gmem_copy (int dthread, size_t doffset,
 	       dthread, (long unsigned) doffset,
 	       (long unsigned) n);
   dpid.rank = dthread;
+#if GUPCR_USE_PORTALS4_TRIGGERED_OPS
+  /* The chunks of this copy go to distinct locations, but those
+     of an earlier copy may not.  */
+  gupcr_gmem_copy_order ();
+  spid.rank = sthread;
+  while (n_rem > 0)
+    {
+      gupcr_gmem_copy_slot_t *slot =
+	&gupcr_gmem_copy_slots[gupcr_gmem_copy_next_slot];
+      size_t n_xfer = GUPCR_MIN (n_rem, chunk_size);
+      gupcr_gmem_copy_next_slot = (gupcr_gmem_copy_next_slot + 1)
+				  % GUPCR_GMEM_COPY_SLOTS;
+      /* Wait for the previous copy through this slot.  */
+      gupcr_gmem_copy_slot_wait (slot);
+      ++slot->num_initiated;
+      /* Write the data to the destination once it has been
+         read into the slot.  */
+      gupcr_portals_call (PtlTriggeredPut,
+			  (slot->put_md, 0, n_xfer, PTL_ACK_REQ, dpid,
+			   GUPCR_PTL_PTE_GMEM, PTL_NO_MATCH_BITS,
+			   dest_addr, PTL_NULL_USER_PTR, PTL_NULL_HDR_DATA,
+			   slot->get_ct, slot->num_initiated));
+      /* Read the source data into the slot.  */
+      gupcr_portals_call (PtlGet, (slot->get_md, 0, n_xfer, spid,
+				   GUPCR_PTL_PTE_GMEM, PTL_NO_MATCH_BITS,
+				   src_addr, PTL_NULL_USER_PTR));
+      gupcr_gmem_copy_pending = 1;
+      n_rem -= n_xfer;
+      src_addr += n_xfer;
+      dest_addr += n_xfer;
+    }
+#else
   while (n_rem > 0)
     {
       size_t n_xfer;
@@ -345,6 +499,7 @@ gupcr_gmem_copy (int dthread, size_t doffset,
       src_addr += n_xfer;
       dest_addr += n_xfer;
     }
+#endif /* GUPCR_USE_PORTALS4_TRIGGERED_OPS */
 }
 
 /**
@@ -412,6 +567,9 @@ gupcr_gmem_init (void)
   ptl_md_t md, md_volatile;
   ptl_le_t le;
   ptl_pt_index_t pte;
+#if GUPCR_USE_PORTALS4_TRIGGERED_OPS
+  int i;
+#endif
   gupcr_log (FC_MEM, "gmem init called");
   /* Allocate memory for this thread's contribution to shared memory.  */
   gupcr_gmem_alloc_shared ();
@@ -478,6 +636,29 @@ gupcr_gmem_init (void)
   md.eq_handle = gupcr_gmem_puts.eq_handle;
   md.ct_handle = gupcr_gmem_puts.ct_handle;
   gupcr_portals_call (PtlMDBind, (gupcr_ptl_ni, &md, &gupcr_gmem_put_bb_md));
+#if GUPCR_USE_PORTALS4_TRIGGERED_OPS
+  /* Initialize remote to remote copy staging buffers.  */
+  for (i = 0; i < GUPCR_GMEM_COPY_SLOTS; ++i)
+    {
+      gupcr_gmem_copy_slot_t *slot = &gupcr_gmem_copy_slots[i];
+      slot->num_initiated = 0;
+      slot->num_completed = 0;
+      gupcr_portals_call (PtlCTAlloc, (gupcr_ptl_ni, &slot->get_ct));
+      md.length = GUPCR_GMEM_COPY_SLOT_SIZE;
+      md.start = slot->buf;
+      md.options = gupcr_gmem_gets.md_options;
+      md.eq_handle = gupcr_gmem_gets.eq_handle;
+      md.ct_handle = slot->get_ct;
+      gupcr_portals_call (PtlMDBind, (gupcr_ptl_ni, &md, &slot->get_md));
+      gupcr_portals_call (PtlCTAlloc, (gupcr_ptl_ni, &slot->put_ct));
+      md.options = gupcr_gmem_puts.md_options;
+      md.eq_handle = gupcr_gmem_puts.eq_handle;
+      md.ct_handle = slot->put_ct;
+      gupcr_portals_call (PtlMDBind, (gupcr_ptl_ni, &md, &slot->put_md));
+    }
+  gupcr_gmem_copy_next_slot = 0;
+  gupcr_gmem_copy_pending = 0;
+#endif /* GUPCR_USE_PORTALS4_TRIGGERED_OPS */
 }
 
 /**
@@ -487,6 +668,9 @@ gupcr_gmem_init (void)
 void
 gupcr_gmem_fini (void)
 {
+#if GUPCR_USE_PORTALS4_TRIGGERED_OPS
+  int i;
+#endif
   gupcr_log (FC_MEM, "gmem fini called");
   /* Release GET MD.  */
   gupcr_portals_call (PtlMDRelease, (gupcr_gmem_gets.md));
@@ -495,6 +679,16 @@ gupcr_gmem_fini (void)
   /* Release PUT MDs.  */
   gupcr_portals_call (PtlMDRelease, (gupcr_gmem_puts.md));
   gupcr_portals_call (PtlMDRelease, (gupcr_gmem_put_bb_md));
+#if GUPCR_USE_PORTALS4_TRIGGERED_OPS
+  /* Release copy staging buffer MDs.  */
+  for (i = 0; i < GUPCR_GMEM_COPY_SLOTS; ++i)
+    {
+      gupcr_portals_call (PtlMDRelease, (gupcr_gmem_copy_slots[i].get_md));
+      gupcr_portals_call (PtlCTFree, (gupcr_gmem_copy_slots[i].get_ct));
+      gupcr_portals_call (PtlMDRelease, (gupcr_gmem_copy_slots[i].put_md));
+      gupcr_portals_call (PtlCTFree, (gupcr_gmem_copy_slots[i].put_ct));
+    }
+#endif
   gupcr_portals_call (PtlCTFree, (gupcr_gmem_puts.ct_handle));
   gupcr_portals_call (PtlEQFree, (gupcr_gmem_puts.eq_handle));
   /* Release LEs and PTEs.  */
@@ -24,6 +24,11 @@
 /* Configuration-defined limits.  */
 /** Maximum size of the message that uses put bounce buffer.  */
 #define GUPCR_GMEM_MAX_SAFE_PUT_SIZE 1*KILOBYTE
+/** Number of staging buffers used to pipeline remote to remote copies.  */
+#define GUPCR_GMEM_COPY_SLOTS 4
+/** Size of each remote to remote copy staging buffer.  */
+#define GUPCR_GMEM_COPY_SLOT_SIZE (GUPCR_BOUNCE_BUFFER_SIZE \
+				   / GUPCR_GMEM_COPY_SLOTS)
 
 /** Max size of the user program.
  *
@@ -40,6 +40,9 @@ int THREADS = -1;
 /** The current thread number (range: 0..THREADS-1) */
 int MYTHREAD = -1;
 
+/** Pointer-to-shared layout of this library (see gupcr_pts.h) */
+const char GUPCR_PTS_LAYOUT_SYMBOL = 1;
+
 /** OK to call finalize routines */
 int gupcr_finalize_ok = 0;
 
@@ -79,6 +82,8 @@ gupcr_init (void)
   int run_threads_count;
   upc_shared_ptr_t heap_region_base;
   size_t heap_region_size;
+  __attribute__ ((unused)) double t_start, t_portals, t_mapping,
+    t_memory, t_end;
 
   /* Initialize Runtime.  */
   if (gupcr_runtime_init ())
@@ -100,6 +105,7 @@ gupcr_init (void)
 
   /* Set up debugging, tracing, statistics, and timing support.  */
   gupcr_utils_init ();
+  t_start = gupcr_clock ();
 
   /* Initialize Portals.  */
   gupcr_portals_init ();
@@ -126,7 +132,9 @@ gupcr_init (void)
 #endif 
 
   /* Initialize the Portals Network Interface.  */
+  t_portals = gupcr_clock ();
   gupcr_portals_ni_init ();
+  t_mapping = gupcr_clock ();
 
   /* Initialize this thread's multi-node tree position.  */
   gupcr_nodetree_setup ();
@@ -134,10 +142,12 @@ gupcr_init (void)
   /* Initialize various runtime components.  */
   gupcr_node_init ();
   gupcr_gmem_init ();
+  t_memory = gupcr_clock ();
   gupcr_lock_init ();
   gupcr_barrier_init ();
   gupcr_broadcast_init ();
   gupcr_coll_init ();
+  gupcr_team_init ();
   gupcr_atomic_init ();
   gupcr_nb_init ();
   gupcr_shutdown_init ();
@@ -148,6 +158,13 @@ gupcr_init (void)
   heap_region_size = gupcr_gmem_heap_size;
   gupcr_alloc_init (heap_region_base, heap_region_size);
 
+  /* Report the time spent in each startup phase.  */
+  t_end = gupcr_clock ();
+  gupcr_stats (FC_INFO, "startup: portals %.6f mapping %.6f "
+	       "memory %.6f other %.6f total %.6f seconds",
+	       t_portals - t_start, t_mapping - t_portals,
+	       t_memory - t_mapping, t_end - t_memory, t_end - t_start);
+
   /* Indicate that runtime initialization is complete.  */
   gupcr_init_complete ();
 
@@ -171,6 +188,7 @@ gupcr_fini (void)
   gupcr_lock_fini ();
   gupcr_gmem_fini ();
   gupcr_node_fini ();
+  gupcr_team_fini ();
   gupcr_coll_fini ();
   gupcr_portals_ni_fini ();
   gupcr_portals_fini ();
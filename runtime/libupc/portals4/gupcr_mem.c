@@ -196,4 +196,46 @@ upc_memset (upc_shared_ptr_t dest, int c, size_t n)
   gupcr_trace (FC_MEM, "MEM MEMSET EXIT");
 }
 
+/**
+ * Initialize the calling thread's part of a statically
+ * initialized shared array.
+ *
+ * This is called by each thread from the UPC initialization
+ * routines.  Only the elements that have affinity to the calling
+ * thread are copied, so no network traffic is generated.
+ *
+ * @param [in] addr Address of the array in the upc_shared section
+ * @param [in] image Initial values of the first "nelems" elements
+ * @param [in] elem_size Size of an array element
+ * @param [in] block_size Block size in elements (0 if indefinite)
+ * @param [in] nelems Number of elements in "image"
+ * @param [in] threads_scale If not zero, the array has
+ *             threads_scale * THREADS elements
+ */
+void
+__upc_shared_array_init (const void *addr, const void *image,
+			 size_t elem_size, size_t block_size,
+			 size_t nelems, size_t threads_scale)
+{
+  const size_t offset = (size_t) ((const char *) addr
+				  - GUPCR_SHARED_SECTION_START);
+  char *local = GUPCR_GMEM_OFF_TO_LOCAL (MYTHREAD, offset);
+  size_t i;
+  if (threads_scale && nelems > threads_scale * THREADS)
+    nelems = threads_scale * THREADS;
+  if (!block_size)
+    {
+      if (!MYTHREAD)
+	memcpy (local, image, nelems * elem_size);
+      return;
+    }
+  for (i = (size_t) MYTHREAD * block_size; i < nelems;
+       i += block_size * THREADS)
+    {
+      const size_t n = GUPCR_MIN (block_size, nelems - i);
+      memcpy (local, (const char *) image + i * elem_size, n * elem_size);
+      local += block_size * elem_size;
+    }
+}
+
 /** @} */
@@ -63,8 +63,10 @@
  *   (4) By using Portals pid-to-nid mappings, each thread searches for
  *       other threads that reside on the same node (same nid).
  *   (5) For each found thread, a POSIX shared object or a file
- *       is opened (in the same manner as under the step 1), mapped,
- *       and verified.
+ *       is opened (in the same manner as under the step 1) and
+ *       mapped.  Each thread walks the list of threads on its node
+ *       starting after its own position, so that threads map
+ *       different peers at the same time.
  *
  * UPC ACCESS
  *   Each thread keeps a private array of addresses to other
@@ -197,16 +199,30 @@ gupcr_node_local_alloc (size_t size)
       /* Wait for all other threads to complete the same.  */
       gupcr_runtime_barrier ();
 
-      /* Map shared memory of other threads on the same node.  */
+      /* Map shared memory of other threads on the same node.
+         Each thread starts with the peer that follows it on the
+         node, so that the peers' shared spaces are mapped by the
+         threads concurrently, rather than all threads opening and
+         mapping the same peer's shared space at the same time.  */
       {
 	int nid = gupcr_get_rank_nid (MYTHREAD);
+	int *peers, npeers = 0, me = 0;
+	gupcr_malloc (peers, THREADS * sizeof (int));
 	for (i = 0; i < THREADS; i++)
 	  {
-	    if (i != MYTHREAD && nid == gupcr_get_rank_nid (i))
-	      {
-		gupcr_node_map[i] = gupcr_mem_local_map (i, size);
-	      }
+	    if (i == MYTHREAD)
+	      me = npeers;
+	    if (nid == gupcr_get_rank_nid (i))
+	      peers[npeers++] = i;
 	  }
+	for (i = 1; i < npeers; i++)
+	  {
+	    int peer = peers[(me + i) % npeers];
+	    gupcr_node_map[peer] = gupcr_mem_local_map (peer, size);
+	  }
+	gupcr_log (FC_MEM, "mapped shared space of %d node local threads",
+		   npeers - 1);
+	gupcr_free (peers);
       }
       /* Make sure everybody completed their mappings.  */
       gupcr_runtime_barrier ();
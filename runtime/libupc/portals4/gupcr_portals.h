@@ -38,6 +38,8 @@
 #define	GUPCR_PTL_PTE_COLL		GUPCR_PTE_BASE+5
 /** Non-blocking transfers PTE */
 #define	GUPCR_PTL_PTE_NB		GUPCR_PTE_BASE+6
+/** Team collectives PTEs (one per team slot) */
+#define	GUPCR_PTL_PTE_TEAM		GUPCR_PTE_BASE+7
 /** @} */
 
 //begin lib_portals
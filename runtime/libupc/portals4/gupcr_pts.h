@@ -117,7 +117,14 @@ typedef upc_shared_ptr_t upc_dbg_shared_ptr_t;
                                  + GUPCR_PTS_THREAD_SIZE)
 #endif
 #define GUPCR_PTS_TO_REP(V) *((upc_shared_ptr_t *)&(V))
-#if GUPCR_TARGET64
+/* A packed pointer-to-shared is either a 64 bit value, or (for
+   large thread counts and shared address spaces) a 128 bit value.  */
+#if (GUPCR_PTS_PHASE_SIZE + GUPCR_PTS_THREAD_SIZE \
+     + GUPCR_PTS_VADDR_SIZE) > 64
+#define GUPCR_PTS_WIDE_REP 1
+#define GUPCR_ONE ((unsigned __int128) 1)
+#define GUPCR_PTS_REP_T unsigned __int128
+#elif GUPCR_TARGET64
 #define GUPCR_ONE 1L
 #define GUPCR_PTS_REP_T unsigned long
 #else
@@ -137,7 +144,15 @@ typedef upc_shared_ptr_t upc_dbg_shared_ptr_t;
    shared pointer layout.  */
 typedef struct shared_ptr_struct
 {
-#if GUPCR_PTS_VADDR_FIRST
+#if GUPCR_PTS_WIDE_REP && GUPCR_PTS_VADDR_FIRST
+  GUPCR_PTS_REP_T vaddr:GUPCR_PTS_VADDR_SIZE;
+  GUPCR_PTS_REP_T thread:GUPCR_PTS_THREAD_SIZE;
+  GUPCR_PTS_REP_T phase:GUPCR_PTS_PHASE_SIZE;
+#elif GUPCR_PTS_WIDE_REP
+  GUPCR_PTS_REP_T phase:GUPCR_PTS_PHASE_SIZE;
+  GUPCR_PTS_REP_T thread:GUPCR_PTS_THREAD_SIZE;
+  GUPCR_PTS_REP_T vaddr:GUPCR_PTS_VADDR_SIZE;
+#elif GUPCR_PTS_VADDR_FIRST
   unsigned long long vaddr:GUPCR_PTS_VADDR_SIZE;
   unsigned int thread:GUPCR_PTS_THREAD_SIZE;
   unsigned int phase:GUPCR_PTS_PHASE_SIZE;
@@ -186,4 +201,26 @@ typedef upc_shared_ptr_t *upc_shared_ptr_p;
 #endif /* GUPCR_PTS_*_REP__ */
 //end lib_pts_defs
 
+/* Every UPC object file refers to a symbol that names the
+   pointer-to-shared layout that it was compiled for,
+   for example __upc_pts_packed_20_10_34_first.  The runtime
+   library defines only the symbol for its own layout, so that
+   objects compiled for a different layout fail to link.  */
+#ifdef GUPCR_PTS_STRUCT_REP
+#define GUPCR_PTS_LAYOUT_REP struct
+#else
+#define GUPCR_PTS_LAYOUT_REP packed
+#endif
+#if GUPCR_PTS_VADDR_FIRST
+#define GUPCR_PTS_LAYOUT_ORDER first
+#else
+#define GUPCR_PTS_LAYOUT_ORDER last
+#endif
+#define GUPCR_PTS_LAYOUT_NAME_1(R,P,T,V,O) __upc_pts_##R##_##P##_##T##_##V##_##O
+#define GUPCR_PTS_LAYOUT_NAME(R,P,T,V,O) GUPCR_PTS_LAYOUT_NAME_1(R,P,T,V,O)
+#define GUPCR_PTS_LAYOUT_SYMBOL \
+  GUPCR_PTS_LAYOUT_NAME (GUPCR_PTS_LAYOUT_REP, GUPCR_PTS_PHASE_SIZE, \
+			 GUPCR_PTS_THREAD_SIZE, GUPCR_PTS_VADDR_SIZE, \
+			 GUPCR_PTS_LAYOUT_ORDER)
+
 #endif /* gupcr_pts.h */
@@ -211,10 +211,50 @@ gupcr_runtime_fini (void)
   return 0;
 }
 
+/**
+ * Get the process IDs of ranks FIRST through FIRST + COUNT - 1,
+ * each published under its own key, and store them in MAPPING.
+ */
+static int
+get_rank_ids (ptl_handle_ni_t ni_h, ptl_process_t *mapping,
+	      int first, int count)
+{
+  int i;
+
+  for (i = first; i < first + count; ++i)
+    {
+      snprintf (key, max_key_len, "libgupc-%lu-%lu",
+		(long unsigned) ni_h, (long unsigned) i);
+      if (PMI_SUCCESS != PMI_KVS_Get (name, key, val, max_val_len))
+	{
+	  return 1;
+	}
+      if (0 != decode (val, &mapping[i], sizeof (mapping[i])))
+	{
+	  return 1;
+	}
+    }
+
+  return 0;
+}
+
+/**
+ * Exchange the process IDs of all ranks.
+ *
+ * Fetching every rank's key from the key-value store
+ * costs each process a number of PMI lookups that grows
+ * with the size of the job (and the job as a whole the square
+ * of that).  The IDs are instead gathered in two levels: each rank
+ * publishes its own ID, the first rank of each block of BLOCK
+ * consecutive ranks collects the IDs of its block and publishes
+ * them as one value, and every process then fetches only the
+ * block values.  BLOCK is the number of encoded IDs that fit into
+ * a single key-value store value.
+ */
 ptl_process_t *
 gupcr_runtime_get_mapping (ptl_handle_ni_t ni_h)
 {
-  int i, ret;
+  int i, ret, block, nblocks, first;
   ptl_process_t my_id;
   struct map_t *map = NULL;
 
@@ -242,23 +282,14 @@ gupcr_runtime_get_mapping (ptl_handle_ni_t ni_h)
   if (PTL_OK != ret)
     return NULL;
 
-  /* Put my information.  */
-  snprintf (key, max_key_len, "libgupc-%lu-%lu-nid",
-	    (long unsigned) ni_h, (long unsigned) rank);
-  if (0 != encode (&my_id.phys.nid, sizeof (my_id.phys.nid), val,
-		   max_val_len))
-    {
-      return NULL;
-    }
-  if (PMI_SUCCESS != PMI_KVS_Put (name, key, val))
-    {
-      return NULL;
-    }
+  map->mapping = malloc (sizeof (ptl_process_t) * size);
+  if (NULL == map->mapping)
+    return NULL;
 
-  snprintf (key, max_key_len, "libgupc-%lu-%lu-pid",
+  /* Put my information.  */
+  snprintf (key, max_key_len, "libgupc-%lu-%lu",
 	    (long unsigned) ni_h, (long unsigned) rank);
-  if (0 != encode (&my_id.phys.pid, sizeof (my_id.phys.pid), val,
-		   max_val_len))
+  if (0 != encode (&my_id, sizeof (my_id), val, max_val_len))
     {
       return NULL;
     }
@@ -277,38 +308,71 @@ gupcr_runtime_get_mapping (ptl_handle_ni_t ni_h)
       return NULL;
     }
 
-  /* Get everyone's information.  */
-  map->mapping = malloc (sizeof (ptl_process_t) * size);
-  if (NULL == map->mapping)
-    return NULL;
+  block = (max_val_len - 1) / (2 * (int) sizeof (ptl_process_t));
+  if (block < 2 || block >= size)
+    {
+      /* Blocks do not save any lookups; get everyone's
+         information directly.  */
+      if (0 != get_rank_ids (ni_h, map->mapping, 0, size))
+	{
+	  return NULL;
+	}
+      map->handle = ni_h;
+      return map->mapping;
+    }
 
-  for (i = 0; i < size; ++i)
+  /* Gather and put my block's information.  */
+  if (0 == rank % block)
     {
-      snprintf (key, max_key_len, "libgupc-%lu-%lu-nid",
-		(long unsigned) ni_h, (long unsigned) i);
-      if (PMI_SUCCESS != PMI_KVS_Get (name, key, val, max_val_len))
+      int count = (rank + block <= size) ? block : size - rank;
+      if (0 != get_rank_ids (ni_h, map->mapping, rank, count))
 	{
 	  return NULL;
 	}
-      if (0 != decode (val, &(map->mapping)[i].phys.nid,
-		       sizeof ((map->mapping)[i].phys.nid)))
+      snprintf (key, max_key_len, "libgupc-%lu-block-%lu",
+		(long unsigned) ni_h, (long unsigned) (rank / block));
+      if (0 != encode (&(map->mapping)[rank], count * sizeof (ptl_process_t),
+		       val, max_val_len))
 	{
 	  return NULL;
 	}
+      if (PMI_SUCCESS != PMI_KVS_Put (name, key, val))
+	{
+	  return NULL;
+	}
+    }
+
+  if (PMI_SUCCESS != PMI_KVS_Commit (name))
+    {
+      return NULL;
+    }
 
-      snprintf (key, max_key_len, "libgupc-%lu-%lu-pid",
+  if (PMI_SUCCESS != PMI_Barrier ())
+    {
+      return NULL;
+    }
+
+  /* Get everyone's information, one block at a time.  */
+  nblocks = (size + block - 1) / block;
+  for (i = 0; i < nblocks; ++i)
+    {
+      int count;
+      first = i * block;
+      count = (first + block <= size) ? block : size - first;
+      snprintf (key, max_key_len, "libgupc-%lu-block-%lu",
 		(long unsigned) ni_h, (long unsigned) i);
       if (PMI_SUCCESS != PMI_KVS_Get (name, key, val, max_val_len))
 	{
 	  return NULL;
 	}
-      if (0 != decode (val, &(map->mapping)[i].phys.pid,
-		       sizeof ((map->mapping)[i].phys.pid)))
+      if (0 != decode (val, &(map->mapping)[first],
+		       count * sizeof (ptl_process_t)))
 	{
 	  return NULL;
 	}
     }
 
+  map->handle = ni_h;
   return map->mapping;
 }
 
@@ -22,6 +22,8 @@
 
 extern void *__cvtaddr (upc_shared_ptr_t);
 extern void *__getaddr (upc_shared_ptr_t);
+extern void __upc_shared_array_init (const void *, const void *, size_t,
+				     size_t, size_t, size_t);
 extern void __upc_barrier (int barrier_id);
 extern void __upc_notify (int barrier_id);
 extern void __upc_wait (int barrier_id);
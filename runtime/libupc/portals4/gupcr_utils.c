@@ -59,6 +59,8 @@ static size_t gupcr_shared_heap_size;
 static int gupcr_node_local_memory = 1;
 static int gupcr_forcetouch = 1;
 static int gupcr_backtrace = 0;
+static int gupcr_coll_fanout = GUPCR_TREE_FANOUT;
+static size_t gupcr_coll_segment_size = GUPCR_COLL_DEFAULT_SEGMENT_SIZE;
 
 static gupcr_open_file_ref gupcr_open_files_list;
 static int gupcr_debug_enabled;
@@ -255,6 +257,41 @@ gupcr_is_forcetouch_enabled (void)
   return gupcr_forcetouch;
 }
 
+void
+gupcr_set_coll_fanout (int value)
+{
+  if (value < 1 || value > GUPCR_TREE_FANOUT)
+    {
+      gupcr_error ("collectives tree fanout (%d) must be in the "
+		   "range 1..%d", value, GUPCR_TREE_FANOUT);
+      return;
+    }
+  gupcr_coll_fanout = value;
+}
+
+int
+gupcr_get_coll_fanout (void)
+{
+  return gupcr_coll_fanout;
+}
+
+void
+gupcr_set_coll_segment_size (size_t value)
+{
+  if (!value)
+    {
+      gupcr_error ("collectives segment size must be greater than zero");
+      return;
+    }
+  gupcr_coll_segment_size = value;
+}
+
+size_t
+gupcr_get_coll_segment_size (void)
+{
+  return gupcr_coll_segment_size;
+}
+
 void
 gupcr_set_backtrace (int value)
 {
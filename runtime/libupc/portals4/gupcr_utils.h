@@ -260,6 +260,8 @@ extern size_t gupcr_get_shared_heap_size (void);
 extern int gupcr_is_node_local_memory_enabled (void);
 extern int gupcr_is_forcetouch_enabled (void);
 extern int gupcr_is_backtrace_enabled (void);
+extern int gupcr_get_coll_fanout (void);
+extern size_t gupcr_get_coll_segment_size (void);
 extern void gupcr_unique_local_name (char *, const char *, int, int);
 extern void gupcr_log_print (const char *fmt, ...)
   __attribute__ ((__format__ (__printf__, 1, 2)));
@@ -285,6 +287,8 @@ extern void gupcr_set_shared_heap_size (size_t heap_size);
 extern void gupcr_set_node_local_memory (int value);
 extern void gupcr_set_forcetouch (int value);
 extern void gupcr_set_backtrace (int value);
+extern void gupcr_set_coll_fanout (int value);
+extern void gupcr_set_coll_segment_size (size_t value);
 extern void gupcr_set_debug_facility (gupcr_facility_t);
 extern void gupcr_set_debug_filename (const char *);
 extern void gupcr_set_log_facility (gupcr_facility_t);
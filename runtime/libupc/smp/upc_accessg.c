@@ -15,6 +15,8 @@
 #include "upc_lib.h"
 #include "gasp_upc.h"
 #include "upc_pupc.h"
+#include "upc_srcline.h"
+#include "upc_heatmap.h"
 
 /* relaxed accesses (profiled) */
 
@@ -23,6 +25,7 @@ __getgqi3 (upc_shared_ptr_t p, const char *filename, int linenum)
 {
   u_intQI_t val;
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (val));
   p_start (GASP_UPC_GET, 1, &val, &p, sizeof (val));
   val = __getqi2 (p);
   p_end (GASP_UPC_GET, 1, &val, &p, sizeof (val));
@@ -35,6 +38,7 @@ __getghi3 (upc_shared_ptr_t p, const char *filename, int linenum)
 {
   u_intHI_t val;
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (val));
   p_start (GASP_UPC_GET, 1, &val, &p, sizeof (val));
   val = __gethi2 (p);
   p_end (GASP_UPC_GET, 1, &val, &p, sizeof (val));
@@ -47,6 +51,7 @@ __getgsi3 (upc_shared_ptr_t p, const char *filename, int linenum)
 {
   u_intSI_t val;
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (val));
   p_start (GASP_UPC_GET, 1, &val, &p, sizeof (val));
   val = __getsi2 (p);
   p_end (GASP_UPC_GET, 1, &val, &p, sizeof (val));
@@ -59,6 +64,7 @@ __getgdi3 (upc_shared_ptr_t p, const char *filename, int linenum)
 {
   u_intDI_t val;
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (val));
   p_start (GASP_UPC_GET, 1, &val, &p, sizeof (val));
   val = __getdi2 (p);
   p_end (GASP_UPC_GET, 1, &val, &p, sizeof (val));
@@ -72,6 +78,7 @@ __getgti3 (upc_shared_ptr_t p, const char *filename, int linenum)
 {
   u_intTI_t val;
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (val));
   p_start (GASP_UPC_GET, 1, &val, &p, sizeof (val));
   val = __getti2 (p);
   p_end (GASP_UPC_GET, 1, &val, &p, sizeof (val));
@@ -85,6 +92,7 @@ __getgsf3 (upc_shared_ptr_t p, const char *filename, int linenum)
 {
   float val;
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (val));
   p_start (GASP_UPC_GET, 1, &val, &p, sizeof (val));
   val = __getsf2 (p);
   p_end (GASP_UPC_GET, 1, &val, &p, sizeof (val));
@@ -97,6 +105,7 @@ __getgdf3 (upc_shared_ptr_t p, const char *filename, int linenum)
 {
   double val;
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (val));
   p_start (GASP_UPC_GET, 1, &val, &p, sizeof (val));
   val = __getdf2 (p);
   p_end (GASP_UPC_GET, 1, &val, &p, sizeof (val));
@@ -109,6 +118,7 @@ __getgtf3 (upc_shared_ptr_t p, const char *filename, int linenum)
 {
   long double val;
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (val));
   p_start (GASP_UPC_GET, 1, &val, &p, sizeof (val));
   val = __gettf2 (p);
   p_end (GASP_UPC_GET, 1, &val, &p, sizeof (val));
@@ -121,6 +131,7 @@ __getgxf3 (upc_shared_ptr_t p, const char *filename, int linenum)
 {
   long double val;
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (val));
   p_start (GASP_UPC_GET, 1, &val, &p, sizeof (val));
   val = __getxf2 (p);
   p_end (GASP_UPC_GET, 1, &val, &p, sizeof (val));
@@ -133,6 +144,7 @@ __getgblk5 (void *dest, upc_shared_ptr_t src, size_t n, const char *filename,
 	    int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (src, n);
   p_start (GASP_UPC_GET, 1, dest, &src, n);
   __getblk3 (dest, src, n);
   p_end (GASP_UPC_GET, 1, dest, &src, n);
@@ -143,6 +155,7 @@ void
 __putgqi4 (upc_shared_ptr_t p, u_intQI_t v, const char *filename, int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (v));
   p_start (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
   __putqi2 (p, v);
   p_end (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
@@ -153,6 +166,7 @@ void
 __putghi4 (upc_shared_ptr_t p, u_intHI_t v, const char *filename, int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (v));
   p_start (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
   __puthi2 (p, v);
   p_end (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
@@ -163,6 +177,7 @@ void
 __putgsi4 (upc_shared_ptr_t p, u_intSI_t v, const char *filename, int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (v));
   p_start (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
   __putsi2 (p, v);
   p_end (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
@@ -173,6 +188,7 @@ void
 __putgdi4 (upc_shared_ptr_t p, u_intDI_t v, const char *filename, int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (v));
   p_start (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
   __putdi2 (p, v);
   p_end (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
@@ -184,6 +200,7 @@ void
 __putgti4 (upc_shared_ptr_t p, u_intTI_t v, const char *filename, int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (v));
   p_start (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
   __putti2 (p, v);
   p_end (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
@@ -195,6 +212,7 @@ void
 __putgsf4 (upc_shared_ptr_t p, float v, const char *filename, int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (v));
   p_start (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
   __putsf2 (p, v);
   p_end (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
@@ -205,6 +223,7 @@ void
 __putgdf4 (upc_shared_ptr_t p, double v, const char *filename, int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (v));
   p_start (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
   __putdf2 (p, v);
   p_end (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
@@ -215,6 +234,7 @@ void
 __putgtf4 (upc_shared_ptr_t p, long double v, const char *filename, int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (v));
   p_start (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
   __puttf2 (p, v);
   p_end (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
@@ -225,6 +245,7 @@ void
 __putgxf4 (upc_shared_ptr_t p, long double v, const char *filename, int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (v));
   p_start (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
   __putxf2 (p, v);
   p_end (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
@@ -236,6 +257,7 @@ __putgblk5 (upc_shared_ptr_t dest, void *src, size_t n, const char *filename,
 	    int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (dest, n);
   p_start (GASP_UPC_PUT, 1, &dest, src, n);
   __putblk3 (dest, src, n);
   p_end (GASP_UPC_PUT, 1, &dest, src, n);
@@ -247,6 +269,8 @@ __copygblk5 (upc_shared_ptr_t dest, upc_shared_ptr_t src, size_t n,
 	     const char *filename, int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (dest, n);
+  GUPCR_HEATMAP_ACCESS (src, n);
   p_start (GASP_UPC_MEMCPY, &dest, &src, n);
   __copyblk3 (dest, src, n);
   p_end (GASP_UPC_MEMCPY, &dest, &src, n);
@@ -260,6 +284,7 @@ __getsgqi3 (upc_shared_ptr_t p, const char *filename, int linenum)
 {
   u_intQI_t val;
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (val));
   p_start (GASP_UPC_GET, 1, &val, &p, sizeof (val));
   val = __getsqi2 (p);
   p_end (GASP_UPC_GET, 1, &val, &p, sizeof (val));
@@ -272,6 +297,7 @@ __getsghi3 (upc_shared_ptr_t p, const char *filename, int linenum)
 {
   u_intHI_t val;
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (val));
   p_start (GASP_UPC_GET, 1, &val, &p, sizeof (val));
   val = __getshi2 (p);
   p_end (GASP_UPC_GET, 1, &val, &p, sizeof (val));
@@ -284,6 +310,7 @@ __getsgsi3 (upc_shared_ptr_t p, const char *filename, int linenum)
 {
   u_intSI_t val;
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (val));
   p_start (GASP_UPC_GET, 1, &val, &p, sizeof (val));
   val = __getssi2 (p);
   p_end (GASP_UPC_GET, 1, &val, &p, sizeof (val));
@@ -296,6 +323,7 @@ __getsgdi3 (upc_shared_ptr_t p, const char *filename, int linenum)
 {
   u_intDI_t val;
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (val));
   p_start (GASP_UPC_GET, 1, &val, &p, sizeof (val));
   val = __getsdi2 (p);
   p_end (GASP_UPC_GET, 1, &val, &p, sizeof (val));
@@ -309,6 +337,7 @@ __getsgti3 (upc_shared_ptr_t p, const char *filename, int linenum)
 {
   u_intTI_t val;
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (val));
   p_start (GASP_UPC_GET, 1, &val, &p, sizeof (val));
   val = __getsti2 (p);
   p_end (GASP_UPC_GET, 1, &val, &p, sizeof (val));
@@ -322,6 +351,7 @@ __getsgsf3 (upc_shared_ptr_t p, const char *filename, int linenum)
 {
   float val;
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (val));
   p_start (GASP_UPC_GET, 1, &val, &p, sizeof (val));
   val = __getssf2 (p);
   p_end (GASP_UPC_GET, 1, &val, &p, sizeof (val));
@@ -334,6 +364,7 @@ __getsgdf3 (upc_shared_ptr_t p, const char *filename, int linenum)
 {
   double val;
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (val));
   p_start (GASP_UPC_GET, 1, &val, &p, sizeof (val));
   val = __getsdf2 (p);
   p_end (GASP_UPC_GET, 1, &val, &p, sizeof (val));
@@ -346,6 +377,7 @@ __getsgtf3 (upc_shared_ptr_t p, const char *filename, int linenum)
 {
   long double val;
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (val));
   p_start (GASP_UPC_GET, 1, &val, &p, sizeof (val));
   val = __getstf2 (p);
   p_end (GASP_UPC_GET, 1, &val, &p, sizeof (val));
@@ -358,6 +390,7 @@ __getsgxf3 (upc_shared_ptr_t p, const char *filename, int linenum)
 {
   long double val;
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (val));
   p_start (GASP_UPC_GET, 1, &val, &p, sizeof (val));
   val = __getsxf2 (p);
   p_end (GASP_UPC_GET, 1, &val, &p, sizeof (val));
@@ -370,6 +403,7 @@ __getsgblk5 (void *dest, upc_shared_ptr_t src, size_t n, const char *filename,
 	     int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (src, n);
   p_start (GASP_UPC_GET, 1, dest, &src, n);
   __getblk3 (dest, src, n);
   p_end (GASP_UPC_GET, 1, dest, &src, n);
@@ -381,6 +415,7 @@ __putsgqi4 (upc_shared_ptr_t p, u_intQI_t v, const char *filename,
 	    int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (v));
   p_start (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
   __putsqi2 (p, v);
   p_end (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
@@ -392,6 +427,7 @@ __putsghi4 (upc_shared_ptr_t p, u_intHI_t v, const char *filename,
 	    int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (v));
   p_start (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
   __putshi2 (p, v);
   p_end (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
@@ -403,6 +439,7 @@ __putsgsi4 (upc_shared_ptr_t p, u_intSI_t v, const char *filename,
 	    int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (v));
   p_start (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
   __putssi2 (p, v);
   p_end (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
@@ -414,6 +451,7 @@ __putsgdi4 (upc_shared_ptr_t p, u_intDI_t v, const char *filename,
 	    int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (v));
   p_start (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
   __putsdi2 (p, v);
   p_end (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
@@ -426,6 +464,7 @@ __putsgti4 (upc_shared_ptr_t p, u_intTI_t v, const char *filename,
 	    int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (v));
   p_start (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
   __putsti2 (p, v);
   p_end (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
@@ -437,6 +476,7 @@ void
 __putsgsf4 (upc_shared_ptr_t p, float v, const char *filename, int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (v));
   p_start (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
   __putssf2 (p, v);
   p_end (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
@@ -447,6 +487,7 @@ void
 __putsgdf4 (upc_shared_ptr_t p, double v, const char *filename, int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (v));
   p_start (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
   __putsdf2 (p, v);
   p_end (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
@@ -457,6 +498,7 @@ void
 __putsgtf4 (upc_shared_ptr_t p, long double v, const char *filename, int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (v));
   p_start (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
   __putstf2 (p, v);
   p_end (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
@@ -467,6 +509,7 @@ void
 __putsgxf4 (upc_shared_ptr_t p, long double v, const char *filename, int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (p, sizeof (v));
   p_start (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
   __putsxf2 (p, v);
   p_end (GASP_UPC_PUT, 1, &p, &v, sizeof (v));
@@ -478,6 +521,7 @@ __putsgblk5 (upc_shared_ptr_t dest, void *src, size_t n, const char *filename,
 	     int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (dest, n);
   p_start (GASP_UPC_PUT, 0, &dest, src, n);
   __putsblk3 (dest, src, n);
   p_end (GASP_UPC_PUT, 0, &dest, src, n);
@@ -489,6 +533,8 @@ __copysgblk5 (upc_shared_ptr_t dest, upc_shared_ptr_t src, size_t n,
 	      const char *filename, int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (dest, n);
+  GUPCR_HEATMAP_ACCESS (src, n);
   p_start (GASP_UPC_MEMCPY, &dest, &src, n);
   __copysblk3 (dest, src, n);
   p_end (GASP_UPC_MEMCPY, &dest, &src, n);
@@ -500,6 +546,8 @@ upc_memcpyg (upc_shared_ptr_t dest, upc_shared_ptr_t src, size_t n,
 	     const char *filename, int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (dest, n);
+  GUPCR_HEATMAP_ACCESS (src, n);
   p_start (GASP_UPC_MEMCPY, &dest, &src, n);
   upc_memcpy (dest, src, n);
   p_end (GASP_UPC_MEMCPY, &dest, &src, n);
@@ -511,6 +559,7 @@ upc_memgetg (void *dest, upc_shared_ptr_t src, size_t n, const char *filename,
 	     int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (src, n);
   p_start (GASP_UPC_MEMGET, &dest, &src, n);
   upc_memget (dest, src, n);
   p_end (GASP_UPC_MEMGET, &dest, &src, n);
@@ -522,6 +571,7 @@ upc_memputg (upc_shared_ptr_t dest, const void *src, size_t n,
 	     const char *filename, int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (dest, n);
   p_start (GASP_UPC_MEMPUT, &dest, src, n);
   upc_memput (dest, src, n);
   p_end (GASP_UPC_MEMPUT, &dest, src, n);
@@ -533,6 +583,7 @@ upc_memsetg (upc_shared_ptr_t dest, int c, size_t n, const char *filename,
 	     int linenum)
 {
   GUPCR_SET_ERR_LOC();
+  GUPCR_HEATMAP_ACCESS (dest, n);
   p_start (GASP_UPC_MEMSET, &dest, c, n);
   upc_memset (dest, c, n);
   p_end (GASP_UPC_MEMSET, &dest, c, n);
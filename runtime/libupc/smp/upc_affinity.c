@@ -202,3 +202,23 @@ __upc_affinity_set (upc_info_p u, int thread_id)
 	  tinfo->sched_affinity, tinfo->mem_affinity);
 #endif /* DEBUG_AFFINITY */
 }
+
+/* Return the NUMA node that THREAD is scheduled to run on,
+   or -1 if it is not known (auto scheduling).  */
+
+int
+__upc_affinity_thread_node (int thread)
+{
+  const upc_info_p u = __upc_info;
+  if (u->sched_policy == GUPCR_SCHED_POLICY_AUTO)
+    return -1;
+  return u->thread_info[thread].mem_affinity;
+}
+
+/* Return the number of NUMA nodes.  */
+
+int
+__upc_affinity_num_nodes (void)
+{
+  return __upc_info->num_nodes;
+}
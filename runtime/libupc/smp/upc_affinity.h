@@ -18,5 +18,7 @@ extern int __upc_affinity_init (const upc_info_p, const upc_cpu_avoid_p,
 				const char **err_msg);
 extern void __upc_affinity_set (const upc_info_p, const int);
 extern int __upc_affinity_supported (void);
+extern int __upc_affinity_thread_node (int);
+extern int __upc_affinity_num_nodes (void);
 
 #endif /* !_UPC_AFFINITY_H_ */
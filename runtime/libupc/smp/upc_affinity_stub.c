@@ -49,3 +49,15 @@ __upc_affinity_set (const upc_info_p ARG_UNUSED (u),
                     const int ARG_UNUSED (thread_id))
 {
 }
+
+int
+__upc_affinity_thread_node (int ARG_UNUSED (thread))
+{
+  return -1;
+}
+
+int
+__upc_affinity_num_nodes (void)
+{
+  return 1;
+}
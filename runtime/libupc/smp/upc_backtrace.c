@@ -179,7 +179,7 @@ __upc_backtrace (void)
 	  if (strstr( *strace_str, "__upc_wait"))
 	    {
 	      fprintf (traceout, "[%4d]       BARRIER ID: %d\n", MYTHREAD, 
-		       __upc_barrier_id);
+		       __upc_tld.barrier_id);
 	    }
           if (strstr (*strace_str, "upc_main"))
 	    under_upc_main = 0;
@@ -13,6 +13,20 @@
 
 #include "config.h"
 
+//begin lib_release_config
+/* The release library variant (and user code compiled with
+   -fupc-release-lib) leaves out runtime checks, debugging,
+   statistics and tracing, including the OpenMP thread checks
+   made on entry to each runtime call.  */
+#if defined (GUPCR_RELEASE_LIB) || defined (__UPC_RELEASE_LIB__)
+#undef GUPCR_HAVE_CHECKS
+#undef GUPCR_HAVE_DEBUG
+#undef GUPCR_HAVE_STATS
+#undef GUPCR_HAVE_TRACE
+#undef GUPCR_HAVE_OMP_CHECKS
+#endif
+//end lib_release_config
+
 #include <ctype.h>
 #include <errno.h>
 #include <fcntl.h>
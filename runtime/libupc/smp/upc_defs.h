@@ -53,9 +53,6 @@ typedef upc_thread_info_t *upc_thread_info_p;
 /* Bit vector used to manage processes */
 typedef os_atomic_t upc_procbits_vec_t[GUPCR_NUM_PROCBIT_WORDS];
 
-/* UPC thread barrier ID  */
-extern GUPCR_THREAD_LOCAL int __upc_barrier_id;
-
 /* There is one global page table per UPC program.
    The global page table maps (thread, page) into
    a global page number in the global memory region. */
@@ -107,6 +104,7 @@ typedef struct upc_info_struct
     int num_nodes;
     upc_sched_policy_t sched_policy;
     upc_mem_policy_t mem_policy;
+    int mem_pretouch;
   } upc_info_t;
 typedef upc_info_t *upc_info_p;
 
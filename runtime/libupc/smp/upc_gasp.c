@@ -11,13 +11,19 @@
 #include "upc_config.h"
 #include "upc_sysdep.h"
 #include "upc_defs.h"
+#include "upc_lib.h"
 #include "gasp.h"
+#include "gasp_upc.h"
+#include "upc_srcline.h"
+#include "upc_prof.h"
 
-/* Since libgupc contains references to these functions, we provide dummy
-   implementations to prevent linker warnings when GASP support has been
-   compiled into GNU UPC, but the user compiles their app regularly.
-   We define these as weak symbols so tools can override them
-   appropriately.  */
+/* Since libgupc contains references to these functions, we provide
+   default implementations to prevent linker warnings when GASP support
+   has been compiled into GNU UPC, but the user compiles their app
+   regularly.  We define these as weak symbols so tools can override
+   them appropriately.  Unless overridden, they forward events to the
+   runtime's built-in profiler, which is enabled by setting the
+   UPC_PROFILE environment variable; otherwise, they do nothing.  */
 
 #pragma weak gasp_init
 #pragma weak gasp_event_notify
@@ -29,38 +35,46 @@ gasp_context_t
 gasp_init (gasp_model_t ARG_UNUSED (srcmodel),
 	   int *ARG_UNUSED (argc), char ***ARG_UNUSED (argv))
 {
-  return 0;
+  return __upc_prof_gasp_init ();
 }
 
 void
-gasp_event_notify (gasp_context_t ARG_UNUSED (context),
-		   unsigned int ARG_UNUSED (evttag),
-		   gasp_evttype_t ARG_UNUSED (evttype),
-		   const char *ARG_UNUSED (filename),
-		   int ARG_UNUSED (linenum), int ARG_UNUSED (colnum), ...)
+gasp_event_notify (gasp_context_t context, unsigned int evttag,
+		   gasp_evttype_t evttype, const char *filename,
+		   int linenum, int colnum, ...)
 {
+  va_list argptr;
+  if (!context)
+    return;
+  va_start (argptr, colnum);
+  __upc_prof_event (context, evttag, evttype, filename, linenum, argptr);
+  va_end (argptr);
 }
 
 void
-gasp_event_notifyVA (gasp_context_t ARG_UNUSED (context),
-		     unsigned int ARG_UNUSED (evttag),
-		     gasp_evttype_t ARG_UNUSED (evttype),
-		     const char *ARG_UNUSED (filename),
-		     int ARG_UNUSED (linenum),
-		     int ARG_UNUSED (colnum), va_list ARG_UNUSED (varargs))
+gasp_event_notifyVA (gasp_context_t context, unsigned int evttag,
+		     gasp_evttype_t evttype, const char *filename,
+		     int linenum, int ARG_UNUSED (colnum), va_list varargs)
 {
+  if (context)
+    __upc_prof_event (context, evttag, evttype, filename, linenum,
+		      varargs);
 }
 
 int
-gasp_control (gasp_context_t ARG_UNUSED (context), int ARG_UNUSED (on))
+gasp_control (gasp_context_t context, int on)
 {
-  return 0;
+  if (!context)
+    return 0;
+  return __upc_prof_control (context, on);
 }
 
 unsigned int
-gasp_create_event (gasp_context_t ARG_UNUSED (context),
+gasp_create_event (gasp_context_t context,
 		   const char *ARG_UNUSED (name),
 		   const char *ARG_UNUSED (desc))
 {
-  return 0;
+  if (!context)
+    return 0;
+  return __upc_prof_create_event (context);
 }
@@ -0,0 +1,206 @@
+/*===-- upc_heatmap.c - UPC Runtime Support Library ----------------------===
+|*
+|*                     The LLVM Compiler Infrastructure
+|*
+|* Copyright 2012-2014, Intrepid Technology, Inc.  All rights reserved.
+|* This file is distributed under a BSD-style Open Source License.
+|* See LICENSE-INTREPID.TXT for details.
+|*
+|*===---------------------------------------------------------------------===*/
+
+/* Communication heat map.
+
+   When the UPC_HEATMAP environment variable is set, the debug-enabled
+   ('g') shared access and lock routines, which are called when the
+   program is compiled with -fupc-debug, record each access in a
+   per-thread table keyed by (source file, line, thread with affinity
+   to the accessed data), and in the accessing thread's row of a
+   THREADS x THREADS communication matrix.
+
+   When the program exits, the monitor writes the communication
+   matrix (bytes and accesses) and the source lines with the largest
+   volume of accesses to other threads' data, to stderr or to the file
+   named by the UPC_HEATMAPFILE environment variable.  */
+
+#include "upc_config.h"
+#include "upc_sysdep.h"
+#include "upc_defs.h"
+#include "upc_srcline.h"
+#include "upc_heatmap.h"
+
+/* Set at startup if the heat map is enabled.  */
+int __upc_heatmap_enabled;
+
+/* Per-thread (source line, thread) tables.  */
+static upc_heatmap_thread_p __upc_heatmap_data;
+
+/* THREADS x THREADS communication matrix.  Row 'i' is
+   only updated by thread 'i'.  */
+static upc_heatmap_cell_p __upc_heatmap_matrix;
+
+static inline upc_heatmap_entry_p
+__upc_heatmap_lookup (upc_heatmap_entry_p table, unsigned int size,
+		      const char *filename, int linenum, int thread)
+{
+  return (upc_heatmap_entry_p)
+    __upc_srcline_lookup (table, sizeof (upc_heatmap_entry_t), size,
+			  filename, linenum, thread);
+}
+
+/* Record an access of NBYTES bytes, made at FILENAME:LINENUM,
+   to data with affinity to THREAD.  */
+
+void
+__upc_heatmap_access (const char *filename, int linenum,
+		      int thread, size_t nbytes)
+{
+  upc_heatmap_thread_p t = &__upc_heatmap_data[MYTHREAD];
+  upc_heatmap_cell_p cell;
+  upc_heatmap_entry_p e;
+  if (thread < 0 || thread >= THREADS)
+    return;
+  cell = &__upc_heatmap_matrix[MYTHREAD * THREADS + thread];
+  cell->count += 1;
+  cell->bytes += nbytes;
+  e = __upc_heatmap_lookup (t->entry, GUPCR_HEATMAP_TABLE_SIZE,
+			    filename, linenum, thread);
+  if (!e)
+    {
+      t->dropped += 1;
+      return;
+    }
+  e->line.count += 1;
+  e->bytes += nbytes;
+}
+
+static int
+__upc_heatmap_cmp_bytes (const void *p1, const void *p2)
+{
+  const upc_heatmap_entry_t *e1 = *(const upc_heatmap_entry_t *const *) p1;
+  const upc_heatmap_entry_t *e2 = *(const upc_heatmap_entry_t *const *) p2;
+  if (e1->bytes != e2->bytes)
+    return (e1->bytes < e2->bytes) ? 1 : -1;
+  return (e1->line.count < e2->line.count) ? 1
+         : (e1->line.count > e2->line.count) ? -1 : 0;
+}
+
+static void
+__upc_heatmap_dump (void)
+{
+  upc_info_p u = __upc_info;
+  upc_heatmap_entry_p merged;
+  upc_heatmap_entry_p *sorted;
+  unsigned long dropped = 0;
+  unsigned int n = 0;
+  FILE *out;
+  int t, d;
+  unsigned int i;
+  merged = calloc (GUPCR_HEATMAP_MERGE_TABLE_SIZE,
+		   sizeof (upc_heatmap_entry_t));
+  sorted = malloc (GUPCR_HEATMAP_MERGE_TABLE_SIZE
+		   * sizeof (upc_heatmap_entry_p));
+  if (!merged || !sorted)
+    {
+      perror ("UPC heat map");
+      return;
+    }
+  out = __upc_srcline_open (GUPCR_HEATMAP_FILE_ENV,
+			    GUPCR_HEATMAP_FILE_DEFAULT);
+  fprintf (out, "# UPC communication heat map: %s, THREADS=%d\n",
+	   u->program_name, THREADS);
+  fprintf (out, "# bytes (row: accessing thread,"
+	   " column: thread with affinity)\n");
+  for (t = 0; t < THREADS; ++t)
+    {
+      upc_heatmap_cell_p row = &__upc_heatmap_matrix[t * THREADS];
+      for (d = 0; d < THREADS; ++d)
+	fprintf (out, "%s%lu", d ? " " : "", row[d].bytes);
+      fputc ('\n', out);
+    }
+  fprintf (out, "# accesses (row: accessing thread,"
+	   " column: thread with affinity)\n");
+  for (t = 0; t < THREADS; ++t)
+    {
+      upc_heatmap_cell_p row = &__upc_heatmap_matrix[t * THREADS];
+      for (d = 0; d < THREADS; ++d)
+	fprintf (out, "%s%lu", d ? " " : "", row[d].count);
+      fputc ('\n', out);
+    }
+  /* Merge the remote accesses of all threads by source line.  */
+  for (t = 0; t < THREADS; ++t)
+    {
+      upc_heatmap_thread_p pt = &__upc_heatmap_data[t];
+      for (i = 0; i < GUPCR_HEATMAP_TABLE_SIZE; ++i)
+	{
+	  upc_heatmap_entry_p e = &pt->entry[i];
+	  upc_heatmap_entry_p m;
+	  if (!e->line.count || e->line.key == t)
+	    continue;
+	  m = __upc_heatmap_lookup (merged, GUPCR_HEATMAP_MERGE_TABLE_SIZE,
+				    e->line.filename, e->line.linenum, -1);
+	  if (!m)
+	    {
+	      dropped += e->line.count;
+	      continue;
+	    }
+	  m->line.count += e->line.count;
+	  m->bytes += e->bytes;
+	}
+      dropped += pt->dropped;
+    }
+  for (i = 0; i < GUPCR_HEATMAP_MERGE_TABLE_SIZE; ++i)
+    if (merged[i].line.count)
+      sorted[n++] = &merged[i];
+  qsort (sorted, n, sizeof (upc_heatmap_entry_p), __upc_heatmap_cmp_bytes);
+  fprintf (out, "# top %d source lines by remote bytes\n",
+	   GUPCR_HEATMAP_TOP_LINES);
+  for (i = 0; i < n && i < GUPCR_HEATMAP_TOP_LINES; ++i)
+    fprintf (out, "%s:%d remote_bytes=%lu remote_accesses=%lu\n",
+	     sorted[i]->line.filename ? sorted[i]->line.filename
+				      : "<unknown>",
+	     sorted[i]->line.linenum, sorted[i]->bytes,
+	     sorted[i]->line.count);
+  if (dropped)
+    fprintf (out, "# %lu accesses not attributed to a source line"
+	     " (heat map table full)\n", dropped);
+  __upc_srcline_close (out);
+  free (sorted);
+  free (merged);
+}
+
+static void
+__upc_heatmap_atexit (void)
+{
+  if (__upc_srcline_is_monitor ())
+    __upc_heatmap_dump ();
+}
+
+/* If the heat map is enabled, allocate the per-thread tables and the
+   communication matrix.  This is called by the monitor before the UPC
+   threads are created.  Return 0 on failure, setting *ERR_MSG.  */
+
+int
+__upc_heatmap_init (upc_info_p u, const char **err_msg)
+{
+  const char *heatmap_env = getenv (GUPCR_HEATMAP_ENV);
+  size_t size;
+  if (!heatmap_env || !strcmp (heatmap_env, "0"))
+    return 1;
+  size = THREADS * sizeof (upc_heatmap_thread_t);
+  __upc_heatmap_data = __upc_runtime_alloc (size, &u->runtime_heap,
+					    err_msg);
+  if (!__upc_heatmap_data)
+    return 0;
+  size = (size_t) THREADS * THREADS * sizeof (upc_heatmap_cell_t);
+  __upc_heatmap_matrix = __upc_runtime_alloc (size, &u->runtime_heap,
+					      err_msg);
+  if (!__upc_heatmap_matrix)
+    return 0;
+  if (atexit (__upc_heatmap_atexit))
+    {
+      *err_msg = "cannot register heat map exit handler";
+      return 0;
+    }
+  __upc_heatmap_enabled = 1;
+  return 1;
+}
@@ -0,0 +1,81 @@
+/*===-- upc_heatmap.h - UPC Runtime Support Library ----------------------===
+|*
+|*                     The LLVM Compiler Infrastructure
+|*
+|* Copyright 2012-2014, Intrepid Technology, Inc.  All rights reserved.
+|* This file is distributed under a BSD-style Open Source License.
+|* See LICENSE-INTREPID.TXT for details.
+|*
+|*===---------------------------------------------------------------------===*/
+
+#ifndef _UPC_HEATMAP_H_
+#define _UPC_HEATMAP_H_
+
+/* Communication heat map.  Shared accesses made through the
+   debug-enabled ('g') runtime library routines are accumulated
+   by (source line, thread with affinity to the accessed data).  */
+
+/* Environment variables. */
+/** Enable the communication heat map (any value other than "0").  */
+#define GUPCR_HEATMAP_ENV "UPC_HEATMAP"
+/** Write the heat map to this file, rather than to stderr.  */
+#define GUPCR_HEATMAP_FILE_ENV "UPC_HEATMAPFILE"
+
+/* Default heat map file name, used if UPC_HEATMAPFILE is empty.  */
+#define GUPCR_HEATMAP_FILE_DEFAULT "upc_heatmap.out"
+
+/* Number of (source line, thread) entries recorded per thread.
+   Must be a power of 2.  */
+#define GUPCR_HEATMAP_TABLE_SIZE 4096
+
+/* Number of entries in the merged per-source line table.
+   Must be a power of 2.  */
+#define GUPCR_HEATMAP_MERGE_TABLE_SIZE (4 * GUPCR_HEATMAP_TABLE_SIZE)
+
+/* Number of source lines listed in the remote volume summary.  */
+#define GUPCR_HEATMAP_TOP_LINES 20
+
+/* Accesses made at a given source line to data with affinity
+   to a given thread.  The key of 'line' is the thread.  */
+typedef struct upc_heatmap_entry_struct
+  {
+    upc_srcline_t line;
+    unsigned long bytes;
+  } upc_heatmap_entry_t;
+typedef upc_heatmap_entry_t *upc_heatmap_entry_p;
+
+/* Per-thread heat map table.  */
+typedef struct upc_heatmap_thread_struct
+  {
+    unsigned long dropped;
+    upc_heatmap_entry_t entry[GUPCR_HEATMAP_TABLE_SIZE];
+  } upc_heatmap_thread_t;
+typedef upc_heatmap_thread_t *upc_heatmap_thread_p;
+
+/* One element of the thread x thread communication matrix.  */
+typedef struct upc_heatmap_cell_struct
+  {
+    unsigned long count;
+    unsigned long bytes;
+  } upc_heatmap_cell_t;
+typedef upc_heatmap_cell_t *upc_heatmap_cell_p;
+
+/* Set at startup (before the UPC threads are created)
+   if the heat map is enabled.  */
+extern int __upc_heatmap_enabled;
+
+extern int __upc_heatmap_init (upc_info_p, const char **);
+extern void __upc_heatmap_access (const char *, int, int, size_t);
+
+/* Record an access of N bytes to the shared data referenced by
+   the shared pointer P.  Used by the debug-enabled library
+   routines, which have 'filename' and 'linenum' arguments.  */
+#define GUPCR_HEATMAP_ACCESS(P, N) \
+  do \
+    { \
+      if (__upc_heatmap_enabled) \
+	__upc_heatmap_access (filename, linenum, \
+			      (int) GUPCR_PTS_THREAD (P), (N)); \
+    } while (0)
+
+#endif /* !_UPC_HEATMAP_H_ */
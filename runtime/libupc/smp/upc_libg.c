@@ -15,6 +15,8 @@
 #include "upc_lib.h"
 #include "gasp_upc.h"
 #include "upc_pupc.h"
+#include "upc_srcline.h"
+#include "upc_heatmap.h"
 
 void
 __upc_barrierg (int barrier_id, const char *filename, const int linenum)
@@ -96,6 +98,7 @@ upc_all_lock_allocg (const char *filename, int linenum)
 void
 upc_lockg (upc_shared_ptr_t ptr, const char *filename, int linenum)
 {
+  GUPCR_HEATMAP_ACCESS (ptr, 0);
   p_start (GASP_UPC_LOCK, &ptr);
   GUPCR_SET_ERR_LOC();
   upc_lock(ptr);
@@ -107,6 +110,7 @@ int
 upc_lock_attemptg (upc_shared_ptr_t ptr, const char *filename, int linenum)
 {
   int status;
+  GUPCR_HEATMAP_ACCESS (ptr, 0);
   p_start (GASP_UPC_LOCK_ATTEMPT, &ptr);
   GUPCR_SET_ERR_LOC();
   status = upc_lock_attempt(ptr);
@@ -118,6 +122,7 @@ upc_lock_attemptg (upc_shared_ptr_t ptr, const char *filename, int linenum)
 void
 upc_unlockg (upc_shared_ptr_t ptr, const char *filename, int linenum)
 {
+  GUPCR_HEATMAP_ACCESS (ptr, 0);
   p_start (GASP_UPC_UNLOCK, &ptr);
   GUPCR_SET_ERR_LOC();
   upc_unlock(ptr);
@@ -20,6 +20,22 @@
 
 
 /* LLVM access routines.  */
+#ifdef GUPCR_USE_PTHREADS
+
+/* In the POSIX threads model, the shared memory of thread T
+   begins at __upc_vm_base + T * __upc_vm_thread_stride; there
+   is no page lookup cache.  */
+//inline
+void *
+__upc_rptr_to_addr (int thread, size_t vaddr)
+{
+  extern char *__upc_vm_base;
+  extern size_t __upc_vm_thread_stride;
+  return __upc_vm_base + thread * __upc_vm_thread_stride + vaddr;
+}
+
+#else /* !GUPCR_USE_PTHREADS */
+
 /* To speed things up, the last two unique (page, thread)
    lookups are cached.  Caller must validate the pointer
    'p' (check for NULL, etc.) before calling this routine. */
@@ -27,8 +43,7 @@
 void *
 __upc_rptr_to_addr (int thread, size_t vaddr)
 {
-  extern GUPCR_THREAD_LOCAL unsigned long __upc_page1_ref, __upc_page2_ref;
-  extern GUPCR_THREAD_LOCAL void *__upc_page1_base, *__upc_page2_base;
+  upc_tld_t *const tld = &__upc_tld;
   void *addr;
   size_t p_offset;
   upc_page_num_t pn;
@@ -36,15 +51,17 @@ __upc_rptr_to_addr (int thread, size_t vaddr)
   p_offset = vaddr & GUPCR_VM_OFFSET_MASK;
   pn = (vaddr >> GUPCR_VM_OFFSET_BITS) & GUPCR_VM_PAGE_MASK;
   this_page = (pn << GUPCR_THREAD_SIZE) | thread;
-  if (this_page == __upc_page1_ref)
-    addr = (char *) __upc_page1_base + p_offset;
-  else if (this_page == __upc_page2_ref)
-    addr = (char *) __upc_page2_base + p_offset;
+  if (this_page == tld->page1_ref)
+    addr = (char *) tld->page1_base + p_offset;
+  else if (this_page == tld->page2_ref)
+    addr = (char *) tld->page2_base + p_offset;
   else
     addr = __upc_vm_map_remote_offset (thread, vaddr);
   return addr;
 }
 
+#endif /* GUPCR_USE_PTHREADS */
+
 //inline
 static void
 __remote_get (long sthread, long saddr, void *dest, size_t n)
@@ -25,8 +25,9 @@
 #define GUPCR_ATOMIC_LOCK_REF_ACCESS 0
 #endif
 /* Lock reference value is a 64 bits value.  If bigger (struct
-   implementation on 64 bit) it must be converted.  */
-#if defined (GUPCR_PTS_STRUCT_REP) && __SIZEOF_POINTER__ == 8
+   or 128 bit packed implementation on 64 bit) it must be converted.  */
+#if (defined (GUPCR_PTS_STRUCT_REP) || GUPCR_PTS_WIDE_REP) \
+    && __SIZEOF_POINTER__ == 8
 #define GUPCR_CONVERT_LOCK_REF 1
 #else
 #define GUPCR_CONVERT_LOCK_REF 0
@@ -53,6 +54,33 @@ typedef union upc_lock_link_ptr upc_link_ref;
 #define SAME_LOCK_REF(P,V) (P.atomic == V.atomic)
 
 typedef struct upc_lock_link_struct upc_lock_link_t;
+typedef struct upc_lock_cohort_struct upc_lock_cohort_t;
+
+/* Values of the lock link 'signal' field.  */
+/* Lock ownership (or, for a cohort lock, the right to
+   acquire the lock's global queue) is passed to the thread.  */
+#define GUPCR_LOCK_SIGNAL_ACQUIRE 1
+/* Cohort lock ownership is passed to the thread, together with
+   the global queue position already held by its cohort.  */
+#define GUPCR_LOCK_SIGNAL_COHORT 2
+
+struct upc_lock_link_struct
+{
+  upc_link_ref next;		  /* Next thread on the waiting list.  */
+  int signal;			  /* Notification of lock ownership.  */
+  int free;			  /* Indication that link block is not used.  */
+  int parked;			  /* Waiting thread may be blocked.  */
+  upc_link_ref link_ref;	  /* Lock reference of this block.  */
+  upc_lock_link_t *link;	  /* Free list link pointer.  */
+} __attribute__ ((aligned(64)));
+
+/* Per NUMA node part of a cohort lock.  */
+struct upc_lock_cohort_struct
+{
+  upc_lock_link_t global_link;	  /* Cohort's global waiting list link.  */
+  upc_link_ref last;		  /* Last thread on the cohort waiting list.  */
+  int passes;			  /* Ownership passes within the cohort.  */
+} __attribute__ ((aligned(64)));
 
 /* upc_lock_t is an opaque shared type.  The 'upc_lock_struct'
    structure describes the internal representation of the
@@ -63,18 +91,12 @@ typedef struct upc_lock_link_struct upc_lock_link_t;
 
 struct upc_lock_struct
 {
-  upc_link_ref last;		/* Last thread on the waiting list.  */
+  upc_link_ref last;		/* Last thread (or cohort, for a cohort
+				   lock) on the waiting list.  */
   upc_link_ref owner_link;	/* Lock owner link block pointer.  */
   upc_lock_t *free_link;
-} __attribute__ ((aligned(64)));
-
-struct upc_lock_link_struct
-{
-  upc_link_ref next;		  /* Next thread on the waiting list.  */
-  int signal;			  /* Notification of lock ownership.  */
-  int free;			  /* Indication that link block is not used.  */
-  upc_link_ref link_ref;	  /* Lock reference of this block.  */
-  upc_lock_link_t *link;	  /* Free list link pointer.  */
+  int cohorts;			/* Number of cohorts (0 if none).  */
+  upc_lock_cohort_t cohort[];	/* Per NUMA node cohorts.  */
 } __attribute__ ((aligned(64)));
 
 /* UPC shared point to C representation. */
@@ -98,7 +120,7 @@ upc_to_link_ref (shared void *p)
       upc_shared_ptr_t v;
     } pts = { .s = p };
   ref.sptr.thread = GUPCR_PTS_THREAD (pts.v);
-  ref.sptr.addr = GUPCR_PTS_VADDR (pts.v);
+  ref.sptr.addr = GUPCR_PTS_OFFSET (pts.v);
   return ref;
 #else
   union pts_as_rep
@@ -17,8 +17,13 @@
 #include "upc_affinity.h"
 #include "upc_numa.h"
 #include "upc_debug.h"
+#include "upc_lib.h"
+#include "gasp.h"
 #include "gasp_upc.h"
 #include "upc_pupc.h"
+#include "upc_srcline.h"
+#include "upc_prof.h"
+#include "upc_heatmap.h"
 #if HAVE_UPC_BACKTRACE
 #include "upc_backtrace.h"
 #endif
@@ -39,6 +44,9 @@ int UPC_PTHREADS = -1;
 /* The current thread number (range: 0..THREADS-1) */
 GUPCR_THREAD_LOCAL int MYTHREAD;
 
+/* Pointer-to-shared layout of this library (see upc_pts.h).  */
+const char GUPCR_PTS_LAYOUT_SYMBOL = 1;
+
 /* Depth count used to implement the semantics of
    nested upc_forall statements.  */
 GUPCR_THREAD_LOCAL int __upc_forall_depth;
@@ -83,6 +91,9 @@ static upc_sched_policy_t __upc_sched_policy = GUPCR_SCHED_POLICY_DEFAULT;
 /* CPU memory affinity policy */
 static upc_mem_policy_t __upc_mem_policy = GUPCR_MEM_POLICY_DEFAULT;
 
+/* Fault in each thread's shared memory pages at start up */
+static int __upc_mem_pretouch = 0;
+
 /* list of CPU's that must be avoided */
 static upc_cpu_avoid_p __upc_cpu_avoid_set;
 
@@ -227,6 +238,8 @@ __upc_print_help_and_exit (char *pgm)
       fprintf (stderr,
 	       "	                                  	  strict - only allocate on local node\n");
     }
+  fprintf (stderr,
+	   "	-mem-pretouch				Fault in shared memory pages at start up\n");
   fprintf (stderr,
 	   "	-g                                  	Turn on UPC source code debugging\n");
 
@@ -432,6 +445,10 @@ __upc_process_switches (char *pgm, int *argc, char *argv[])
 	    }
 	  __upc_shift_args (argc, argv);
 	}
+      else if (!strcmp (arg, "-mem-pretouch"))
+	{
+	  __upc_mem_pretouch = 1;
+	}
       else if (!strcmp (arg, "-g"))
 	{
 	  __upc_gum_debug = 1;
@@ -508,7 +525,9 @@ __upc_init (char *pgm, const char **err_msg)
   upc_info_p u;
   os_heap_p runtime_heap;
   size_t alloc_data_size, local_size, max_init_alloc, heap_size;
+#ifndef GUPCR_USE_PTHREADS
   size_t mmap_fn_len;
+#endif
   char mmap_file_name[2046];
   upc_page_num_t init_page_alloc;
   const size_t gpt_size = (GUPCR_VM_MAX_PAGES_PER_THREAD * THREADS)
@@ -537,6 +556,7 @@ __upc_init (char *pgm, const char **err_msg)
   u->num_nodes = 1;
   u->sched_policy = __upc_sched_policy;
   u->mem_policy = __upc_mem_policy;
+  u->mem_pretouch = __upc_mem_pretouch;
 
   /* MPIR_partial_attach_ok support.  */
   if (MPIR_being_debugged)
@@ -564,6 +584,12 @@ __upc_init (char *pgm, const char **err_msg)
   u->init_heap_size = heap_size;
   GUPCR_PTS_SET_NULL_SHARED (u->init_heap_base);
   GUPCR_PTS_SET_VADDR (u->init_heap_base, alloc_data_size);
+#ifdef GUPCR_USE_PTHREADS
+  /* All threads share a single address space; the global shared
+     memory is an anonymous region created by __upc_vm_init().
+     There is no global memory file, and no GPT.  */
+  u->smem_fd = -1;
+#else
   u->smem_fd = __upc_create_global_mem_file (mmap_file_name, err_msg);
   if (u->smem_fd < 0)
     return 0;
@@ -580,6 +606,7 @@ __upc_init (char *pgm, const char **err_msg)
   u->gpt = (upc_pte_p) __upc_runtime_alloc (gpt_size, &runtime_heap, err_msg);
   if (!u->gpt)
     return 0;
+#endif /* GUPCR_USE_PTHREADS */
   return u;
 }
 
@@ -601,6 +628,8 @@ __upc_per_thread_init (upc_info_p u)
   const int n_init = (int)(GUPCR_INIT_ARRAY_END - GUPCR_INIT_ARRAY_START);
   int i;
   __upc_vm_init_per_thread ();
+  if (u->mem_pretouch)
+    __upc_vm_pretouch_per_thread ();
   __upc_lock_init ();
   __upc_heap_init (u->init_heap_base, u->init_heap_size);
   __upc_barrier_init ();
@@ -1028,11 +1057,6 @@ __upc_run_threads (upc_info_p u, int argc, char *argv[])
 	}
       u->thread_info[thread_id].os_thread = pthread_id;
     }
-  if (unlink (u->mmap_file_name) < 0)
-    {
-      perror ("cannot unlink global shared memory file");
-      abort ();
-    }
 }
 
 /* Wait for all pthreads to exit. This implementation requires
@@ -1146,6 +1170,8 @@ GUPCR_START (int argc, char *argv[])
   __upc_validate_pgm_info (__upc_pgm_name);
   __upc_cpu_avoid_set = __upc_affinity_cpu_avoid_new ();
   __upc_process_switches (__upc_pgm_name, &argc, argv);
+  __upc_spin_wait_init ();
+  __upc_mem_bulk_init ();
   u = __upc_init (__upc_pgm_name, &err_msg);
   if (!u)
     {
@@ -1164,8 +1190,6 @@ GUPCR_START (int argc, char *argv[])
      __upc_info has been allocated and initialized, because __upc_init_lock
      refers to __upc_info on some platforms (eg, SGI/Irix).  */
   __upc_init_lock (&u->lock);
-  /* Initialize the VM system */
-  __upc_vm_init (u->init_page_alloc);
   /* Initialize thread affinity */
   if (!__upc_affinity_init (u, __upc_cpu_avoid_set, &err_msg))
     {
@@ -1175,6 +1199,19 @@ GUPCR_START (int argc, char *argv[])
       abort ();
     }
   __upc_affinity_cpu_avoid_free (__upc_cpu_avoid_set);
+  /* Initialize the VM system.  This is done after the thread
+     affinity has been calculated, so that the initial pages
+     can be placed on the node of the thread they belong to.  */
+  __upc_vm_init (u->init_page_alloc);
+  /* Allocate the built-in profiler's and the communication heat map's
+     per-thread tables, if enabled.  */
+  if (!__upc_prof_init (u, &err_msg) || !__upc_heatmap_init (u, &err_msg))
+    {
+      fprintf (stderr, "%s: UPC initialization failed.\n"
+	       "%s: reason: %s\n", __upc_pgm_name, __upc_pgm_name, err_msg);
+      __upc_notify_debugger_of_abort (err_msg);
+      abort ();
+    }
   /* Ensure that the upc_forall depth count is initialized to 0.  */
   __upc_forall_depth = 0;
   /* Run the program */
@@ -38,3 +38,46 @@ upc_memset (upc_shared_ptr_t dest, int c, size_t n)
 {
   __upc_memset (dest, c, n);
 }
+
+/* Initialize the calling thread's part of a statically initialized
+   shared array.  ADDR is the address of the array in the upc_shared
+   section, and IMAGE holds the initial values of its first NELEMS
+   elements, in array index order.  Each element is ELEM_SIZE bytes,
+   and the array has a block size of BLOCK_SIZE elements (0 for an
+   indefinite block size).  If THREADS_SCALE is not zero, the array
+   has THREADS_SCALE * THREADS elements.
+
+   This is called by each thread from the UPC initialization
+   routines; it copies only the elements that have affinity to the
+   calling thread, so that no remote accesses are made.  */
+
+void
+__upc_shared_array_init (const void *addr, const void *image,
+			 size_t elem_size, size_t block_size,
+			 size_t nelems, size_t threads_scale)
+{
+  const size_t offset = (size_t) ((const char *) addr
+				  - GUPCR_SHARED_SECTION_START);
+  const size_t block_bytes = block_size * elem_size;
+  upc_shared_ptr_t dest;
+  size_t i;
+  if (threads_scale && nelems > threads_scale * THREADS)
+    nelems = threads_scale * THREADS;
+  GUPCR_PTS_SET_NULL_SHARED (dest);
+  GUPCR_PTS_SET_VADDR (dest, offset);
+  GUPCR_PTS_SET_THREAD (dest, MYTHREAD);
+  if (!block_size)
+    {
+      if (!MYTHREAD)
+	__upc_memput (dest, image, nelems * elem_size);
+      return;
+    }
+  for (i = (size_t) MYTHREAD * block_size; i < nelems;
+       i += block_size * THREADS)
+    {
+      const size_t n = GUPCR_MIN (block_size, nelems - i);
+      __upc_memput (dest, (const char *) image + i * elem_size,
+		    n * elem_size);
+      GUPCR_PTS_SET_VADDR (dest, GUPCR_PTS_OFFSET (dest) + block_bytes);
+    }
+}
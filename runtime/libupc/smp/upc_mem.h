@@ -17,6 +17,13 @@
 
 //begin lib_inline_mem_sup
 
+/* Transfers of at least this many bytes are made
+   by the bulk copy routines (upc_mem_bulk.c).  */
+extern size_t __upc_mem_bulk_threshold;
+extern void __upc_memcpy_bulk (upc_shared_ptr_t, upc_shared_ptr_t, size_t);
+extern void __upc_memget_bulk (void *, upc_shared_ptr_t, size_t);
+extern void __upc_memput_bulk (upc_shared_ptr_t, const void *, size_t);
+
 __attribute__((__always_inline__))
 static inline
 void
@@ -26,6 +33,11 @@ __upc_memcpy (upc_shared_ptr_t dest, upc_shared_ptr_t src, size_t n)
     __upc_fatal ("Invalid access via null shared pointer");
   if (GUPCR_PTS_IS_NULL (dest))
     __upc_fatal ("Invalid access via null shared pointer");
+  if (n >= __upc_mem_bulk_threshold)
+    {
+      __upc_memcpy_bulk (dest, src, n);
+      return;
+    }
   for (;;)
     {
       char *srcp = (char *)__upc_sptr_to_addr (src);
@@ -55,6 +67,11 @@ __upc_memget (void *dest, upc_shared_ptr_t src, size_t n)
     __upc_fatal ("Invalid access via null shared pointer");
   if (GUPCR_PTS_IS_NULL (src))
     __upc_fatal ("Invalid access via null shared pointer");
+  if (n >= __upc_mem_bulk_threshold)
+    {
+      __upc_memget_bulk (dest, src, n);
+      return;
+    }
   for (;;)
     {
       char *srcp = (char *)__upc_sptr_to_addr (src);
@@ -79,6 +96,11 @@ __upc_memput (upc_shared_ptr_t dest, const void *src, size_t n)
     __upc_fatal ("Invalid access via null shared pointer");
   if (GUPCR_PTS_IS_NULL (dest))
     __upc_fatal ("Invalid access via null shared pointer");
+  if (n >= __upc_mem_bulk_threshold)
+    {
+      __upc_memput_bulk (dest, src, n);
+      return;
+    }
   for (;;)
     {
       char *destp = (char *)__upc_sptr_to_addr (dest);
@@ -0,0 +1,363 @@
+/*===-- upc_mem_bulk.c - UPC Runtime Support Library ---------------------===
+|*
+|*                     The LLVM Compiler Infrastructure
+|*
+|* Copyright 2012-2014, Intrepid Technology, Inc.  All rights reserved.
+|* This file is distributed under a BSD-style Open Source License.
+|* See LICENSE-INTREPID.TXT for details.
+|*
+|*===---------------------------------------------------------------------===*/
+
+#include "upc_config.h"
+#include "upc_sysdep.h"
+#include "upc_defs.h"
+#include "upc_sup.h"
+#include "upc_sync.h"
+#include "upc_access.h"
+#include "upc_mem.h"
+#include <pthread.h>
+#include <signal.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/* Bulk copy.
+
+   upc_memcpy, upc_memget and upc_memput transfers of at least
+   __upc_mem_bulk_threshold bytes are made by the routines in this
+   file rather than by the inline routines in upc_mem.h.  As there,
+   the transfer is made one UPC VM page at a time, but:
+
+   * Stores are non-temporal (where the target supports them),
+     so that a large transfer does not evict the working set
+     of the calling thread from the cache.
+   * The source is prefetched ahead of the copy.  The source
+     address of the next page is translated before the current
+     page is copied, so that prefetching continues across the
+     page boundary.
+   * If UPC_MEM_HELPERS is set, each page is split into pieces that
+     are copied by that many helper (POSIX) threads together with
+     the calling thread.  The helper threads are created by each
+     UPC thread when it first needs them.  Only the calling thread
+     translates addresses; at most three pages (the current source
+     and destination pages, and the next source page) are in use
+     at a time, which does not exceed the VM map set size.  */
+
+/* Environment variables.  */
+/** Size (in bytes, optionally followed by K, M or G) of the smallest
+    transfer made by the bulk copy routines.  Zero disables them.  */
+#define GUPCR_MEM_BULK_THRESHOLD_ENV "UPC_MEM_BULK_THRESHOLD"
+/** Number of helper threads that copy a bulk transfer along
+    with the calling thread.  The default is zero.  */
+#define GUPCR_MEM_HELPERS_ENV "UPC_MEM_HELPERS"
+
+/* Default size of the smallest bulk transfer.  */
+#define GUPCR_MEM_BULK_THRESHOLD_DEFAULT (4*MEGABYTE)
+/* Maximum number of helper threads per UPC thread.  */
+#define GUPCR_MEM_HELPERS_MAX 64
+/* Smallest piece of a page copied by a helper thread.  */
+#define GUPCR_MEM_HELPER_PIECE_MIN (256*KILOBYTE)
+/* Distance (in bytes) ahead of the copy at which the source
+   is prefetched.  */
+#define GUPCR_MEM_PREFETCH_DISTANCE 512
+
+size_t __upc_mem_bulk_threshold = GUPCR_MEM_BULK_THRESHOLD_DEFAULT;
+
+/* Number of helper threads.  */
+static int upc_mem_helpers;
+
+/* Helper threads of a UPC thread.  The calling thread posts a page
+   copy ('job') by incrementing 'generation'.  The page is copied in
+   'npieces' pieces of 'piece' bytes, which are claimed through
+   'next_piece' by the helper threads and the calling thread.  'busy'
+   counts the helper threads that may still claim a piece; it is only
+   incremented with 'lock' held, and the calling thread changes the
+   job only when it holds 'lock' and 'busy' is zero.  */
+typedef struct upc_mem_helper_pool_struct
+{
+  pthread_mutex_t lock;
+  pthread_cond_t start;
+  unsigned long generation;
+  int busy;
+  char *dest;
+  const char *src;
+  size_t n;
+  size_t piece;
+  size_t npieces;
+  size_t next_piece;
+  size_t done_pieces;
+} upc_mem_helper_pool_t;
+
+static GUPCR_THREAD_LOCAL upc_mem_helper_pool_t *upc_mem_helper_pool;
+
+/* One side of a transfer: either a pointer-to-shared,
+   translated one page at a time, or a local address.  */
+typedef struct upc_mem_side_struct
+{
+  int is_shared;
+  upc_shared_ptr_t sptr;
+  char *addr;
+} upc_mem_side_t;
+
+/* Return the address of SIDE, and reduce *N to the number
+   of bytes that are contiguous at that address.  */
+__attribute__ ((__always_inline__))
+static inline
+char *
+upc_mem_side_addr (upc_mem_side_t *side, size_t *n)
+{
+  if (side->is_shared)
+    {
+      const size_t p_offset = GUPCR_PTS_OFFSET (side->sptr)
+			      & GUPCR_VM_OFFSET_MASK;
+      *n = GUPCR_MIN (GUPCR_VM_PAGE_SIZE - p_offset, *n);
+      return (char *) __upc_sptr_to_addr (side->sptr);
+    }
+  return side->addr;
+}
+
+__attribute__ ((__always_inline__))
+static inline
+void
+upc_mem_side_advance (upc_mem_side_t *side, size_t n)
+{
+  if (side->is_shared)
+    GUPCR_PTS_INCR_VADDR (side->sptr, n);
+  else
+    side->addr += n;
+}
+
+/* Copy N bytes from SRC to DEST with non-temporal stores.
+   NEXT_SRC, if not NULL, is the source of the next copy;
+   prefetching continues there as the end of SRC is reached.  */
+static void
+upc_mem_stream_copy (char *dest, const char *src, size_t n,
+		     const char *next_src)
+{
+#ifdef __SSE2__
+  const char *const src_end = src + n;
+  const size_t head = -(size_t) dest & 15;
+  if (n < head + 64)
+    {
+      memcpy (dest, src, n);
+      return;
+    }
+  memcpy (dest, src, head);
+  dest += head;
+  src += head;
+  n -= head;
+  for (; n >= 64; n -= 64, dest += 64, src += 64)
+    {
+      const char *pf = src + GUPCR_MEM_PREFETCH_DISTANCE;
+      __m128i x0, x1, x2, x3;
+      if (pf >= src_end)
+	pf = next_src ? next_src + (pf - src_end) : NULL;
+      if (pf)
+	__builtin_prefetch (pf, 0, 0);
+      x0 = _mm_loadu_si128 ((const __m128i *) src);
+      x1 = _mm_loadu_si128 ((const __m128i *) (src + 16));
+      x2 = _mm_loadu_si128 ((const __m128i *) (src + 32));
+      x3 = _mm_loadu_si128 ((const __m128i *) (src + 48));
+      _mm_stream_si128 ((__m128i *) dest, x0);
+      _mm_stream_si128 ((__m128i *) (dest + 16), x1);
+      _mm_stream_si128 ((__m128i *) (dest + 32), x2);
+      _mm_stream_si128 ((__m128i *) (dest + 48), x3);
+    }
+  memcpy (dest, src, n);
+  /* Order the non-temporal stores before subsequent stores.  */
+  _mm_sfence ();
+#else
+  if (next_src)
+    __builtin_prefetch (next_src, 0, 0);
+  memcpy (dest, src, n);
+#endif
+}
+
+/* Copy the unclaimed pieces of the current job of POOL.  */
+static void
+upc_mem_helper_work (upc_mem_helper_pool_t *pool)
+{
+  size_t i;
+  while ((i = __atomic_fetch_add (&pool->next_piece, 1, __ATOMIC_ACQUIRE))
+	 < pool->npieces)
+    {
+      const size_t offset = i * pool->piece;
+      const size_t len = GUPCR_MIN (pool->piece, pool->n - offset);
+      upc_mem_stream_copy (pool->dest + offset, pool->src + offset,
+			   len, NULL);
+      __atomic_add_fetch (&pool->done_pieces, 1, __ATOMIC_RELEASE);
+    }
+}
+
+static void *
+upc_mem_helper (void *arg)
+{
+  upc_mem_helper_pool_t *pool = (upc_mem_helper_pool_t *) arg;
+  unsigned long generation = 0;
+  pthread_mutex_lock (&pool->lock);
+  for (;;)
+    {
+      while (pool->generation == generation)
+	pthread_cond_wait (&pool->start, &pool->lock);
+      generation = pool->generation;
+      __atomic_add_fetch (&pool->busy, 1, __ATOMIC_RELAXED);
+      pthread_mutex_unlock (&pool->lock);
+      upc_mem_helper_work (pool);
+      __atomic_sub_fetch (&pool->busy, 1, __ATOMIC_RELEASE);
+      pthread_mutex_lock (&pool->lock);
+    }
+  return NULL;
+}
+
+/* Create the calling UPC thread's helper threads.  Signals are
+   blocked in the helper threads, so that they are delivered
+   to the UPC thread.  */
+static upc_mem_helper_pool_t *
+upc_mem_helper_pool_create (void)
+{
+  upc_mem_helper_pool_t *pool;
+  pthread_attr_t attr;
+  sigset_t all_signals, old_signals;
+  int i;
+  pool = calloc (1, sizeof (upc_mem_helper_pool_t));
+  if (!pool)
+    __upc_fatal ("cannot allocate UPC memory copy helpers");
+  pthread_mutex_init (&pool->lock, NULL);
+  pthread_cond_init (&pool->start, NULL);
+  pthread_attr_init (&attr);
+  pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+  sigfillset (&all_signals);
+  pthread_sigmask (SIG_SETMASK, &all_signals, &old_signals);
+  for (i = 0; i < upc_mem_helpers; ++i)
+    {
+      pthread_t id;
+      if (pthread_create (&id, &attr, upc_mem_helper, pool))
+	__upc_fatal ("cannot create UPC memory copy helper thread");
+    }
+  pthread_sigmask (SIG_SETMASK, &old_signals, NULL);
+  pthread_attr_destroy (&attr);
+  return pool;
+}
+
+/* Copy N bytes from SRC to DEST with the helper threads.  */
+static void
+upc_mem_helper_copy (char *dest, const char *src, size_t n)
+{
+  upc_mem_helper_pool_t *pool = upc_mem_helper_pool;
+  const size_t piece = GUPCR_MAX (GUPCR_ROUND (n / (upc_mem_helpers + 1),
+					       64),
+				  GUPCR_MEM_HELPER_PIECE_MIN);
+  if (!pool)
+    pool = upc_mem_helper_pool = upc_mem_helper_pool_create ();
+  pthread_mutex_lock (&pool->lock);
+  while (__atomic_load_n (&pool->busy, __ATOMIC_ACQUIRE))
+    __upc_cpu_relax ();
+  pool->dest = dest;
+  pool->src = src;
+  pool->n = n;
+  pool->piece = piece;
+  pool->npieces = (n + piece - 1) / piece;
+  pool->next_piece = 0;
+  pool->done_pieces = 0;
+  ++pool->generation;
+  pthread_cond_broadcast (&pool->start);
+  pthread_mutex_unlock (&pool->lock);
+  upc_mem_helper_work (pool);
+  while (__atomic_load_n (&pool->done_pieces, __ATOMIC_ACQUIRE)
+	 < pool->npieces)
+    __upc_cpu_relax ();
+}
+
+/* Copy N bytes from SRC to DEST, one contiguous
+   (page) segment at a time.  */
+static void
+upc_mem_bulk_copy (upc_mem_side_t *dest, upc_mem_side_t *src, size_t n)
+{
+  size_t len = n;
+  const char *srcp = upc_mem_side_addr (src, &len);
+  while (n)
+    {
+      char *destp = upc_mem_side_addr (dest, &len);
+      const char *next_srcp = NULL;
+      size_t next_len = 0;
+      upc_mem_side_advance (dest, len);
+      upc_mem_side_advance (src, len);
+      n -= len;
+      if (n)
+	{
+	  next_len = n;
+	  next_srcp = upc_mem_side_addr (src, &next_len);
+	}
+      if (upc_mem_helpers && len >= 2 * GUPCR_MEM_HELPER_PIECE_MIN)
+	upc_mem_helper_copy (destp, srcp, len);
+      else
+	upc_mem_stream_copy (destp, srcp, len, next_srcp);
+      srcp = next_srcp;
+      len = next_len;
+    }
+}
+
+void
+__upc_memcpy_bulk (upc_shared_ptr_t dest, upc_shared_ptr_t src, size_t n)
+{
+  upc_mem_side_t d = {.is_shared = 1,.sptr = dest };
+  upc_mem_side_t s = {.is_shared = 1,.sptr = src };
+  upc_mem_bulk_copy (&d, &s, n);
+}
+
+void
+__upc_memget_bulk (void *dest, upc_shared_ptr_t src, size_t n)
+{
+  upc_mem_side_t d = {.is_shared = 0,.addr = (char *) dest };
+  upc_mem_side_t s = {.is_shared = 1,.sptr = src };
+  upc_mem_bulk_copy (&d, &s, n);
+}
+
+void
+__upc_memput_bulk (upc_shared_ptr_t dest, const void *src, size_t n)
+{
+  upc_mem_side_t d = {.is_shared = 1,.sptr = dest };
+  upc_mem_side_t s = {.is_shared = 0,.addr = (char *) src };
+  upc_mem_bulk_copy (&d, &s, n);
+}
+
+/* Set the bulk copy threshold and the number of helper threads
+   from the environment.  Called before THREADS is known.  */
+void
+__upc_mem_bulk_init (void)
+{
+  const char *threshold_env = getenv (GUPCR_MEM_BULK_THRESHOLD_ENV);
+  const char *helpers_env = getenv (GUPCR_MEM_HELPERS_ENV);
+  if (threshold_env)
+    {
+      char *end;
+      long long threshold = strtoll (threshold_env, &end, 10);
+      if (*end == 'k' || *end == 'K')
+	threshold *= KILOBYTE, ++end;
+      else if (*end == 'm' || *end == 'M')
+	threshold *= MEGABYTE, ++end;
+      else if (*end == 'g' || *end == 'G')
+	threshold *= (long long) KILOBYTE * MEGABYTE, ++end;
+      if (end == threshold_env || *end || threshold < 0)
+	{
+	  fprintf (stderr, "UPC error: invalid %s value: %s\n",
+		   GUPCR_MEM_BULK_THRESHOLD_ENV, threshold_env);
+	  exit (2);
+	}
+      __upc_mem_bulk_threshold = threshold ? (size_t) threshold
+					   : (size_t) -1;
+    }
+  if (helpers_env)
+    {
+      char *end;
+      long helpers = strtol (helpers_env, &end, 10);
+      if (end == helpers_env || *end || helpers < 0
+	  || helpers > GUPCR_MEM_HELPERS_MAX)
+	{
+	  fprintf (stderr, "UPC error: invalid %s value: %s\n",
+		   GUPCR_MEM_HELPERS_ENV, helpers_env);
+	  exit (2);
+	}
+      upc_mem_helpers = (int) helpers;
+    }
+}
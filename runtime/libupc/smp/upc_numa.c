@@ -9,11 +9,13 @@
 |*===---------------------------------------------------------------------===*/
 
 #include <numa.h>
+#include <numaif.h>
 #include "upc_config.h"
 #include "upc_sysdep.h"
 #include "upc_defs.h"
 #include "upc_sup.h"
 #include "upc_affinity.h"
+#include "upc_numa.h"
 
 int
 __upc_numa_supported (void)
@@ -90,7 +92,12 @@ __upc_numa_memory_affinity_set (const upc_info_p u, const int thread_id)
     }
 }
 
-/* Set affinity for memory region */
+/* Set affinity for memory region.  The memory region has affinity
+   to THREAD_ID, which need not be the calling thread.  The pages of
+   the region are bound to (or, for the "node" memory policy, preferably
+   allocated on) the thread's node.  For shared memory files, the policy
+   is kept by the file, so it applies no matter which thread first
+   touches a page, and it outlives the mapping of REGION.  */
 
 void
 __upc_numa_memory_region_affinity_set (const upc_info_p u,
@@ -100,9 +107,17 @@ __upc_numa_memory_region_affinity_set (const upc_info_p u,
   if ((u->sched_policy != GUPCR_SCHED_POLICY_AUTO) &&
          (u->mem_policy != GUPCR_MEM_POLICY_AUTO))
     {
-      /* memory is being allocated with affinity to "thread" */
-      if (thread_id == MYTHREAD)
-	numa_tonode_memory ((void *) region, size,
-			    u->thread_info[thread_id].mem_affinity);
+      const int node = u->thread_info[thread_id].mem_affinity;
+      const int mode = (u->mem_policy == GUPCR_MEM_POLICY_STRICT)
+		       ? MPOL_BIND : MPOL_PREFERRED;
+      unsigned long nodemask[GUPCR_NUMA_MASK_WORDS];
+      const int bits_per_word = 8 * sizeof (unsigned long);
+      if (node < 0 || node >= GUPCR_NUMA_MASK_WORDS * bits_per_word)
+	return;
+      memset (nodemask, '\0', sizeof (nodemask));
+      nodemask[node / bits_per_word] |= 1UL << (node % bits_per_word);
+      /* Placement is advisory; ignore failures.  */
+      (void) mbind ((void *) region, size, mode, nodemask,
+		    GUPCR_NUMA_MASK_WORDS * bits_per_word + 1, 0);
     }
 }
@@ -19,6 +19,9 @@ extern int __upc_numa_allocate (const upc_info_p u, const int thread_id,
 				const char **err_msg);
 extern void __upc_numa_sched_set (const upc_info_p, const int);
 extern void __upc_numa_memory_affinity_set (const upc_info_p, const int);
+/* Number of words in the node masks passed to mbind().  */
+#define GUPCR_NUMA_MASK_WORDS 16
+
 extern void __upc_numa_memory_region_affinity_set (const upc_info_p u,
 						   const int thread_id,
 						   const void *region,
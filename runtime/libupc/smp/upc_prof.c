@@ -0,0 +1,418 @@
+/*===-- upc_prof.c - UPC Runtime Support Library -------------------------===
+|*
+|*                     The LLVM Compiler Infrastructure
+|*
+|* Copyright 2012-2014, Intrepid Technology, Inc.  All rights reserved.
+|* This file is distributed under a BSD-style Open Source License.
+|* See LICENSE-INTREPID.TXT for details.
+|*
+|*===---------------------------------------------------------------------===*/
+
+/* Built-in GASP profiling tool.
+
+   When the UPC_PROFILE environment variable is set, each UPC thread
+   records, for every (event type, source line) pair: the number of
+   events, the number of bytes transferred, how many of those events
+   and bytes referred to shared data with affinity to some other
+   thread, the total and maximum time spent, and a log2 histogram
+   of the time taken by each event.  Source file and line information
+   is provided by the debug-enabled ('g') runtime library routines,
+   which are called when the program is compiled with -fupc-debug;
+   otherwise, all events are attributed to the runtime.
+
+   When the program exits, the monitor merges the per-thread tables
+   and writes the profile to stderr or to the file named by the
+   UPC_PROFILEFILE environment variable.  */
+
+#include "upc_config.h"
+#include "upc_sysdep.h"
+#include "upc_defs.h"
+#include "upc_lib.h"
+#include "gasp.h"
+#include "gasp_upc.h"
+#include "upc_srcline.h"
+#include "upc_prof.h"
+
+/* Per-thread profile tables, indexed by thread number.  */
+static upc_prof_thread_p __upc_prof_data;
+
+static const char *const __upc_prof_event_names[] = {
+  [GASP_C_FUNC] = "func",
+  [GASP_UPC_COLLECTIVE_EXIT] = "collective_exit",
+  [GASP_UPC_NONCOLLECTIVE_EXIT] = "noncollective_exit",
+  [GASP_UPC_NOTIFY] = "notify",
+  [GASP_UPC_WAIT] = "wait",
+  [GASP_UPC_BARRIER] = "barrier",
+  [GASP_UPC_FORALL] = "forall",
+  [GASP_UPC_GLOBAL_ALLOC] = "global_alloc",
+  [GASP_UPC_ALL_ALLOC] = "all_alloc",
+  [GASP_UPC_ALLOC] = "alloc",
+  [GASP_UPC_FREE] = "free",
+  [GASP_UPC_GLOBAL_LOCK_ALLOC] = "global_lock_alloc",
+  [GASP_UPC_ALL_LOCK_ALLOC] = "all_lock_alloc",
+  [GASP_UPC_LOCK_FREE] = "lock_free",
+  [GASP_UPC_LOCK] = "lock",
+  [GASP_UPC_LOCK_ATTEMPT] = "lock_attempt",
+  [GASP_UPC_UNLOCK] = "unlock",
+  [GASP_UPC_MEMCPY] = "memcpy",
+  [GASP_UPC_MEMGET] = "memget",
+  [GASP_UPC_MEMPUT] = "memput",
+  [GASP_UPC_MEMSET] = "memset",
+  [GASP_UPC_GET] = "get",
+  [GASP_UPC_PUT] = "put",
+  [GASP_UPC_ALL_BROADCAST] = "all_broadcast",
+  [GASP_UPC_ALL_SCATTER] = "all_scatter",
+  [GASP_UPC_ALL_GATHER] = "all_gather",
+  [GASP_UPC_ALL_GATHER_ALL] = "all_gather_all",
+  [GASP_UPC_ALL_EXCHANGE] = "all_exchange",
+  [GASP_UPC_ALL_PERMUTE] = "all_permute",
+  [GASP_UPC_ALL_REDUCE] = "all_reduce",
+  [GASP_UPC_ALL_PREFIX_REDUCE] = "all_prefix_reduce",
+};
+
+#define GUPCR_PROF_N_EVENT_NAMES \
+  (sizeof (__upc_prof_event_names) / sizeof (__upc_prof_event_names[0]))
+
+static const char *
+__upc_prof_event_name (unsigned int evttag, char *buf, size_t len)
+{
+  if (evttag < GUPCR_PROF_N_EVENT_NAMES && __upc_prof_event_names[evttag])
+    return __upc_prof_event_names[evttag];
+  if (evttag >= GASP_UPC_USEREVT_START && evttag <= GASP_UPC_USEREVT_END)
+    snprintf (buf, len, "user_%u", evttag - GASP_UPC_USEREVT_START);
+  else
+    snprintf (buf, len, "event_%u", evttag);
+  return buf;
+}
+
+static inline upc_prof_entry_p
+__upc_prof_lookup (upc_prof_entry_p table, unsigned int size,
+		   unsigned int evttag, const char *filename, int linenum)
+{
+  return (upc_prof_entry_p)
+    __upc_srcline_lookup (table, sizeof (upc_prof_entry_t), size,
+			  filename, linenum, (int) evttag);
+}
+
+static inline int
+__upc_prof_pts_remote (gasp_upc_PTS_t *p)
+{
+  return p && GUPCR_PTS_THREAD (*(upc_shared_ptr_t *) p) != (size_t) MYTHREAD;
+}
+
+/* Extract the number of bytes transferred by event EVTTAG from its
+   arguments, and whether shared data with affinity to another
+   thread was referenced.  */
+
+static size_t
+__upc_prof_event_bytes (unsigned int evttag, va_list args, int *remote)
+{
+  gasp_upc_PTS_t *dst, *src;
+  size_t nbytes, nblocks;
+  *remote = 0;
+  switch (evttag)
+    {
+    case GASP_UPC_GET:
+    case GASP_UPC_MEMGET:
+      if (evttag == GASP_UPC_GET)
+	(void) va_arg (args, int);
+      (void) va_arg (args, void *);
+      src = va_arg (args, gasp_upc_PTS_t *);
+      *remote = __upc_prof_pts_remote (src);
+      return va_arg (args, size_t);
+    case GASP_UPC_PUT:
+    case GASP_UPC_MEMPUT:
+      if (evttag == GASP_UPC_PUT)
+	(void) va_arg (args, int);
+      dst = va_arg (args, gasp_upc_PTS_t *);
+      (void) va_arg (args, void *);
+      *remote = __upc_prof_pts_remote (dst);
+      return va_arg (args, size_t);
+    case GASP_UPC_MEMCPY:
+      dst = va_arg (args, gasp_upc_PTS_t *);
+      src = va_arg (args, gasp_upc_PTS_t *);
+      *remote = __upc_prof_pts_remote (dst) || __upc_prof_pts_remote (src);
+      return va_arg (args, size_t);
+    case GASP_UPC_MEMSET:
+      dst = va_arg (args, gasp_upc_PTS_t *);
+      (void) va_arg (args, int);
+      *remote = __upc_prof_pts_remote (dst);
+      return va_arg (args, size_t);
+    case GASP_UPC_ALLOC:
+      return va_arg (args, size_t);
+    case GASP_UPC_GLOBAL_ALLOC:
+    case GASP_UPC_ALL_ALLOC:
+      nblocks = va_arg (args, size_t);
+      nbytes = va_arg (args, size_t);
+      return nblocks * nbytes;
+    case GASP_UPC_ALL_BROADCAST:
+    case GASP_UPC_ALL_SCATTER:
+    case GASP_UPC_ALL_GATHER:
+    case GASP_UPC_ALL_GATHER_ALL:
+    case GASP_UPC_ALL_EXCHANGE:
+    case GASP_UPC_ALL_PERMUTE:
+      (void) va_arg (args, gasp_upc_PTS_t *);
+      (void) va_arg (args, gasp_upc_PTS_t *);
+      if (evttag == GASP_UPC_ALL_PERMUTE)
+	(void) va_arg (args, gasp_upc_PTS_t *);
+      *remote = THREADS > 1;
+      return va_arg (args, size_t);
+    default:
+      break;
+    }
+  return 0;
+}
+
+static void
+__upc_prof_record (upc_prof_thread_p t, unsigned int evttag,
+		   const char *filename, int linenum,
+		   size_t nbytes, int remote, uint64_t ns)
+{
+  upc_prof_entry_p e;
+  unsigned int bucket;
+  e = __upc_prof_lookup (t->entry, GUPCR_PROF_TABLE_SIZE,
+			 evttag, filename, linenum);
+  if (!e)
+    {
+      t->dropped += 1;
+      return;
+    }
+  e->line.count += 1;
+  e->bytes += nbytes;
+  if (remote)
+    {
+      e->remote_count += 1;
+      e->remote_bytes += nbytes;
+    }
+  e->total_ns += ns;
+  if (ns > e->max_ns)
+    e->max_ns = ns;
+  bucket = ns ? 63 - __builtin_clzll (ns) : 0;
+  if (bucket >= GUPCR_PROF_HIST_BUCKETS)
+    bucket = GUPCR_PROF_HIST_BUCKETS - 1;
+  e->hist[bucket] += 1;
+}
+
+/* GASP event notification.  Start events push their start time;
+   end and atomic events are recorded along with the elapsed time
+   since the matching start event (zero for atomic events).  */
+
+void
+__upc_prof_event (gasp_context_t context, unsigned int evttag,
+		  gasp_evttype_t evttype, const char *filename, int linenum,
+		  va_list args)
+{
+  upc_prof_thread_p t = (upc_prof_thread_p) context;
+  uint64_t ns = 0;
+  size_t nbytes;
+  int remote;
+  if (!t->enabled)
+    return;
+  if (evttype == GASP_START)
+    {
+      if (t->depth < GUPCR_PROF_STACK_DEPTH)
+	{
+	  t->stack[t->depth].evttag = evttag;
+	  t->stack[t->depth].start = upc_ticks_now ();
+	}
+      t->depth += 1;
+      return;
+    }
+  if (evttype == GASP_END && t->depth > 0)
+    {
+      t->depth -= 1;
+      if (t->depth < GUPCR_PROF_STACK_DEPTH
+	  && t->stack[t->depth].evttag == evttag)
+	ns = upc_ticks_to_ns (upc_ticks_now () - t->stack[t->depth].start);
+    }
+  nbytes = __upc_prof_event_bytes (evttag, args, &remote);
+  __upc_prof_record (t, evttag, filename, linenum, nbytes, remote, ns);
+}
+
+int
+__upc_prof_control (gasp_context_t context, int on)
+{
+  upc_prof_thread_p t = (upc_prof_thread_p) context;
+  int was_enabled = t->enabled;
+  t->enabled = on;
+  return was_enabled;
+}
+
+unsigned int
+__upc_prof_create_event (gasp_context_t context)
+{
+  upc_prof_thread_p t = (upc_prof_thread_p) context;
+  unsigned int evttag = GASP_UPC_USEREVT_START + t->next_user_evt;
+  if (evttag >= GASP_UPC_USEREVT_END)
+    return GASP_UPC_USEREVT_END;
+  t->next_user_evt += 1;
+  return evttag;
+}
+
+/* Return the GASP context of the calling thread, or NULL if
+   profiling is disabled.  */
+
+gasp_context_t
+__upc_prof_gasp_init (void)
+{
+  upc_prof_thread_p t;
+  if (!__upc_prof_data)
+    return NULL;
+  t = &__upc_prof_data[MYTHREAD];
+  t->enabled = 1;
+  return (gasp_context_t) t;
+}
+
+static int
+__upc_prof_cmp_time (const void *p1, const void *p2)
+{
+  const upc_prof_entry_t *e1 = *(const upc_prof_entry_t *const *) p1;
+  const upc_prof_entry_t *e2 = *(const upc_prof_entry_t *const *) p2;
+  if (e1->total_ns != e2->total_ns)
+    return (e1->total_ns < e2->total_ns) ? 1 : -1;
+  return (e1->line.count < e2->line.count) ? 1
+         : (e1->line.count > e2->line.count) ? -1 : 0;
+}
+
+static int
+__upc_prof_cmp_remote (const void *p1, const void *p2)
+{
+  const upc_prof_entry_t *e1 = *(const upc_prof_entry_t *const *) p1;
+  const upc_prof_entry_t *e2 = *(const upc_prof_entry_t *const *) p2;
+  if (e1->remote_bytes != e2->remote_bytes)
+    return (e1->remote_bytes < e2->remote_bytes) ? 1 : -1;
+  return (e1->remote_count < e2->remote_count) ? 1
+         : (e1->remote_count > e2->remote_count) ? -1 : 0;
+}
+
+static void
+__upc_prof_print_entry (FILE *out, const upc_prof_entry_t *e)
+{
+  char evtbuf[32];
+  int b;
+  fprintf (out, "%-18s %s:%d count=%lu bytes=%lu remote=%lu"
+	   " remote_bytes=%lu total_ns=%llu max_ns=%llu hist=",
+	   __upc_prof_event_name ((unsigned int) e->line.key,
+				  evtbuf, sizeof (evtbuf)),
+	   e->line.filename ? e->line.filename : "<runtime>",
+	   e->line.linenum,
+	   e->line.count, e->bytes, e->remote_count, e->remote_bytes,
+	   (unsigned long long) e->total_ns, (unsigned long long) e->max_ns);
+  for (b = 0; b < GUPCR_PROF_HIST_BUCKETS; ++b)
+    if (e->hist[b])
+      fprintf (out, "[2^%d]:%u,", b, e->hist[b]);
+  fputc ('\n', out);
+}
+
+/* Merge the per-thread tables and write the profile.  */
+
+static void
+__upc_prof_dump (void)
+{
+  upc_info_p u = __upc_info;
+  upc_prof_entry_p merged;
+  upc_prof_entry_p *sorted;
+  unsigned long dropped = 0;
+  unsigned int n = 0;
+  FILE *out;
+  int t;
+  unsigned int i, b;
+  merged = calloc (GUPCR_PROF_MERGE_TABLE_SIZE, sizeof (upc_prof_entry_t));
+  sorted = malloc (GUPCR_PROF_MERGE_TABLE_SIZE * sizeof (upc_prof_entry_p));
+  if (!merged || !sorted)
+    {
+      perror ("UPC profile");
+      return;
+    }
+  out = __upc_srcline_open (GUPCR_PROF_FILE_ENV, GUPCR_PROF_FILE_DEFAULT);
+  fprintf (out, "# UPC profile: %s, THREADS=%d\n",
+	   u->program_name, THREADS);
+  fprintf (out, "# per-thread totals\n");
+  for (t = 0; t < THREADS; ++t)
+    {
+      upc_prof_thread_p pt = &__upc_prof_data[t];
+      unsigned long events = 0, bytes = 0, remote_bytes = 0;
+      uint64_t total_ns = 0;
+      for (i = 0; i < GUPCR_PROF_TABLE_SIZE; ++i)
+	{
+	  upc_prof_entry_p e = &pt->entry[i];
+	  upc_prof_entry_p m;
+	  if (!e->line.count)
+	    continue;
+	  events += e->line.count;
+	  bytes += e->bytes;
+	  remote_bytes += e->remote_bytes;
+	  total_ns += e->total_ns;
+	  m = __upc_prof_lookup (merged, GUPCR_PROF_MERGE_TABLE_SIZE,
+				 (unsigned int) e->line.key,
+				 e->line.filename, e->line.linenum);
+	  if (!m)
+	    {
+	      dropped += e->line.count;
+	      continue;
+	    }
+	  m->line.count += e->line.count;
+	  m->bytes += e->bytes;
+	  m->remote_count += e->remote_count;
+	  m->remote_bytes += e->remote_bytes;
+	  m->total_ns += e->total_ns;
+	  if (e->max_ns > m->max_ns)
+	    m->max_ns = e->max_ns;
+	  for (b = 0; b < GUPCR_PROF_HIST_BUCKETS; ++b)
+	    m->hist[b] += e->hist[b];
+	}
+      dropped += pt->dropped;
+      fprintf (out, "thread %d: events=%lu bytes=%lu remote_bytes=%lu"
+	       " event_ns=%llu\n", t, events, bytes, remote_bytes,
+	       (unsigned long long) total_ns);
+    }
+  for (i = 0; i < GUPCR_PROF_MERGE_TABLE_SIZE; ++i)
+    if (merged[i].line.count)
+      sorted[n++] = &merged[i];
+  fprintf (out, "# events by total time\n");
+  qsort (sorted, n, sizeof (upc_prof_entry_p), __upc_prof_cmp_time);
+  for (i = 0; i < n; ++i)
+    __upc_prof_print_entry (out, sorted[i]);
+  fprintf (out, "# top %d source lines by remote bytes\n",
+	   GUPCR_PROF_TOP_LINES);
+  qsort (sorted, n, sizeof (upc_prof_entry_p), __upc_prof_cmp_remote);
+  for (i = 0; i < n && i < GUPCR_PROF_TOP_LINES; ++i)
+    if (sorted[i]->remote_count)
+      __upc_prof_print_entry (out, sorted[i]);
+  if (dropped)
+    fprintf (out, "# %lu events not recorded (profile table full)\n",
+	     dropped);
+  __upc_srcline_close (out);
+  free (sorted);
+  free (merged);
+}
+
+static void
+__upc_prof_atexit (void)
+{
+  if (__upc_srcline_is_monitor ())
+    __upc_prof_dump ();
+}
+
+/* If profiling is enabled, allocate the per-thread profile tables.
+   This is called by the monitor before the UPC threads are created.
+   Return 0 on failure, setting *ERR_MSG.  */
+
+int
+__upc_prof_init (upc_info_p u, const char **err_msg)
+{
+  const char *prof_env = getenv (GUPCR_PROF_ENV);
+  size_t size;
+  if (!prof_env || !strcmp (prof_env, "0"))
+    return 1;
+  size = THREADS * sizeof (upc_prof_thread_t);
+  __upc_prof_data = __upc_runtime_alloc (size, &u->runtime_heap, err_msg);
+  if (!__upc_prof_data)
+    return 0;
+  if (atexit (__upc_prof_atexit))
+    {
+      *err_msg = "cannot register profile exit handler";
+      return 0;
+    }
+  return 1;
+}
@@ -0,0 +1,88 @@
+/*===-- upc_prof.h - UPC Runtime Support Library -------------------------===
+|*
+|*                     The LLVM Compiler Infrastructure
+|*
+|* Copyright 2012-2014, Intrepid Technology, Inc.  All rights reserved.
+|* This file is distributed under a BSD-style Open Source License.
+|* See LICENSE-INTREPID.TXT for details.
+|*
+|*===---------------------------------------------------------------------===*/
+
+#ifndef _UPC_PROF_H_
+#define _UPC_PROF_H_
+
+/* Built-in GASP profiling tool.  It is used by the default
+   (weak) GASP entry points in upc_gasp.c, unless an external
+   performance tool provides its own definitions.  */
+
+/* Environment variables. */
+/** Enable the built-in profiler (any value other than "0").  */
+#define GUPCR_PROF_ENV "UPC_PROFILE"
+/** Write the profile to this file, rather than to stderr.  */
+#define GUPCR_PROF_FILE_ENV "UPC_PROFILEFILE"
+
+/* Default profile file name, used if UPC_PROFILEFILE is empty.  */
+#define GUPCR_PROF_FILE_DEFAULT "upc_profile.out"
+
+/* Number of (event, source line) entries recorded per thread.
+   Must be a power of 2.  */
+#define GUPCR_PROF_TABLE_SIZE 1024
+
+/* Number of entries in the merged (all threads) table.
+   Must be a power of 2.  */
+#define GUPCR_PROF_MERGE_TABLE_SIZE (4 * GUPCR_PROF_TABLE_SIZE)
+
+/* Number of buckets in each time histogram.  Bucket 'i' counts
+   the events that took [2^i, 2^(i+1)) nanoseconds.  */
+#define GUPCR_PROF_HIST_BUCKETS 32
+
+/* Maximum nesting depth of start/end event pairs that are timed.  */
+#define GUPCR_PROF_STACK_DEPTH 16
+
+/* Number of source lines listed in the remote traffic summary.  */
+#define GUPCR_PROF_TOP_LINES 20
+
+/* Profile data for a single (event, source line) pair.
+   The key of 'line' is the event tag.  */
+typedef struct upc_prof_entry_struct
+  {
+    upc_srcline_t line;
+    unsigned long bytes;
+    unsigned long remote_count;
+    unsigned long remote_bytes;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    unsigned int hist[GUPCR_PROF_HIST_BUCKETS];
+  } upc_prof_entry_t;
+typedef upc_prof_entry_t *upc_prof_entry_p;
+
+/* Start time of an event that has not yet ended.  */
+typedef struct upc_prof_start_struct
+  {
+    unsigned int evttag;
+    upc_tick_t start;
+  } upc_prof_start_t;
+
+/* Per-thread profile data.  The per-thread tables are allocated
+   in memory that is shared by all UPC threads, so that the
+   monitor can merge them when the program exits.  Each thread
+   only ever updates its own table.  */
+typedef struct upc_prof_thread_struct
+  {
+    int enabled;
+    int depth;
+    unsigned int next_user_evt;
+    unsigned long dropped;
+    upc_prof_start_t stack[GUPCR_PROF_STACK_DEPTH];
+    upc_prof_entry_t entry[GUPCR_PROF_TABLE_SIZE];
+  } upc_prof_thread_t;
+typedef upc_prof_thread_t *upc_prof_thread_p;
+
+extern int __upc_prof_init (upc_info_p, const char **);
+extern gasp_context_t __upc_prof_gasp_init (void);
+extern void __upc_prof_event (gasp_context_t, unsigned int, gasp_evttype_t,
+			      const char *, int, va_list);
+extern int __upc_prof_control (gasp_context_t, int);
+extern unsigned int __upc_prof_create_event (gasp_context_t);
+
+#endif /* !_UPC_PROF_H_ */
@@ -0,0 +1,91 @@
+/*===-- upc_srcline.c - UPC Runtime Support Library ----------------------===
+|*
+|*                     The LLVM Compiler Infrastructure
+|*
+|* Copyright 2012-2014, Intrepid Technology, Inc.  All rights reserved.
+|* This file is distributed under a BSD-style Open Source License.
+|* See LICENSE-INTREPID.TXT for details.
+|*
+|*===---------------------------------------------------------------------===*/
+
+#include "upc_config.h"
+#include "upc_sysdep.h"
+#include "upc_defs.h"
+#include "upc_srcline.h"
+
+static inline unsigned int
+__upc_srcline_hash (const char *filename, int linenum, int key)
+{
+  unsigned long h = (unsigned long) filename >> 3;
+  h ^= (unsigned long) linenum * 2654435761UL;
+  h ^= (unsigned long) key * 40503UL;
+  return (unsigned int) (h ^ (h >> 16));
+}
+
+/* Find the entry for (FILENAME, LINENUM, KEY) in TABLE, which has
+   SIZE entries of ENTRY_SIZE bytes; SIZE must be a power of 2.
+   Allocate a new entry if needed.  Return NULL if the table
+   is full.  */
+
+upc_srcline_p
+__upc_srcline_lookup (void *table, size_t entry_size, unsigned int size,
+		      const char *filename, int linenum, int key)
+{
+  unsigned int mask = size - 1;
+  unsigned int i = __upc_srcline_hash (filename, linenum, key) & mask;
+  unsigned int probe;
+  for (probe = 0; probe < size; ++probe, i = (i + 1) & mask)
+    {
+      upc_srcline_p e = (upc_srcline_p) ((char *) table + i * entry_size);
+      if (!e->count)
+	{
+	  e->filename = filename;
+	  e->linenum = linenum;
+	  e->key = key;
+	  return e;
+	}
+      if (e->key == key && e->linenum == linenum
+	  && e->filename == filename)
+	return e;
+    }
+  return NULL;
+}
+
+/* Open the report file named by the environment variable FILE_ENV,
+   or DEFAULT_NAME if it is set but empty.  Return stderr if
+   FILE_ENV is not set or the file cannot be opened.  */
+
+FILE *
+__upc_srcline_open (const char *file_env, const char *default_name)
+{
+  const char *name = getenv (file_env);
+  FILE *out;
+  if (!name)
+    return stderr;
+  if (!strlen (name))
+    name = default_name;
+  out = fopen (name, "w");
+  if (!out)
+    {
+      perror (name);
+      return stderr;
+    }
+  return out;
+}
+
+void
+__upc_srcline_close (FILE *out)
+{
+  if (out != stderr)
+    fclose (out);
+}
+
+/* Return 1 if called by the monitor (or by the single thread that
+   runs in the monitor process); only it writes the reports.  */
+
+int
+__upc_srcline_is_monitor (void)
+{
+  upc_info_p u = __upc_info;
+  return u && getpid () == u->monitor_pid;
+}
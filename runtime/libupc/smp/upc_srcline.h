@@ -0,0 +1,35 @@
+/*===-- upc_srcline.h - UPC Runtime Support Library ----------------------===
+|*
+|*                     The LLVM Compiler Infrastructure
+|*
+|* Copyright 2012-2014, Intrepid Technology, Inc.  All rights reserved.
+|* This file is distributed under a BSD-style Open Source License.
+|* See LICENSE-INTREPID.TXT for details.
+|*
+|*===---------------------------------------------------------------------===*/
+
+#ifndef _UPC_SRCLINE_H_
+#define _UPC_SRCLINE_H_
+
+/* Per-source line tables, used by the built-in profiler and the
+   communication heat map.  A table is an open addressed hash table
+   of entries that begin with a upc_srcline_t, keyed by (source file,
+   line, KEY); the meaning of KEY is up to the user of the table.  */
+
+typedef struct upc_srcline_struct
+  {
+    const char *filename;
+    int linenum;
+    int key;
+    /* Number of events recorded; zero if the entry is unused.  */
+    unsigned long count;
+  } upc_srcline_t;
+typedef upc_srcline_t *upc_srcline_p;
+
+extern upc_srcline_p __upc_srcline_lookup (void *, size_t, unsigned int,
+					   const char *, int, int);
+extern FILE *__upc_srcline_open (const char *, const char *);
+extern void __upc_srcline_close (FILE *);
+extern int __upc_srcline_is_monitor (void);
+
+#endif /* !_UPC_SRCLINE_H_ */
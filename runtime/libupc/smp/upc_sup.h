@@ -16,6 +16,8 @@
 
 extern void *__cvtaddr (upc_shared_ptr_t);
 extern void *__getaddr (upc_shared_ptr_t);
+extern void __upc_shared_array_init (const void *, const void *, size_t,
+				     size_t, size_t, size_t);
 extern void __upc_barrier (int barrier_id);
 extern void __upc_notify (int barrier_id);
 extern void __upc_wait (int barrier_id);
@@ -58,11 +60,52 @@ extern void __upc_heap_init (upc_shared_ptr_t, size_t);
 extern int __upc_start (int argc, char *argv[]);
 extern void __upc_validate_pgm_info (char *);
 extern void __upc_vm_init_per_thread (void);
+extern void __upc_vm_pretouch_per_thread (void);
 extern void __upc_vm_init (upc_page_num_t);
 extern void __upc_barrier_init (void);
+extern void __upc_mem_bulk_init (void);
 
 //begin lib_sptr_to_addr
 
+/* Per-thread runtime state used by shared accesses and barriers.
+   In the POSIX threads model, each thread local variable is reached
+   through its own TLS address computation; keeping this state in
+   one cache line sized block reduces that to a single one.  */
+struct upc_tld_struct
+{
+  /* The last two unique (page, thread) lookups, and their
+     local addresses.  */
+  unsigned long page1_ref, page2_ref;
+  void *page1_base, *page2_base;
+  /* Active barrier ID.  */
+  int barrier_id;
+  /* Set by upc_notify() and cleared by upc_wait().  */
+  int barrier_active;
+} __attribute__ ((aligned(64)));
+typedef struct upc_tld_struct upc_tld_t;
+
+extern GUPCR_THREAD_LOCAL upc_tld_t __upc_tld;
+
+#ifdef GUPCR_USE_PTHREADS
+
+/* In the POSIX threads model, the shared memory of all UPC threads
+   is a single region, mapped at the same address in all threads.
+   The shared memory of thread T begins at
+   __upc_vm_base + T * __upc_vm_thread_stride.  Caller must validate
+   the pointer 'p' (check for NULL, etc.) before calling this routine. */
+__attribute__((__always_inline__))
+static inline
+void *
+__upc_sptr_to_addr (upc_shared_ptr_t p)
+{
+  extern char *__upc_vm_base;
+  extern size_t __upc_vm_thread_stride;
+  return __upc_vm_base + GUPCR_PTS_THREAD (p) * __upc_vm_thread_stride
+         + GUPCR_PTS_OFFSET (p);
+}
+
+#else /* !GUPCR_USE_PTHREADS */
+
 /* To speed things up, the last two unique (page, thread)
    lookups are cached.  Caller must validate the pointer
    'p' (check for NULL, etc.) before calling this routine. */
@@ -71,8 +114,7 @@ static inline
 void *
 __upc_sptr_to_addr (upc_shared_ptr_t p)
 {
-  extern GUPCR_THREAD_LOCAL unsigned long __upc_page1_ref, __upc_page2_ref;
-  extern GUPCR_THREAD_LOCAL void *__upc_page1_base, *__upc_page2_base;
+  upc_tld_t *const tld = &__upc_tld;
   void *addr;
   size_t offset, p_offset;
   upc_page_num_t pn;
@@ -81,15 +123,17 @@ __upc_sptr_to_addr (upc_shared_ptr_t p)
   p_offset = offset & GUPCR_VM_OFFSET_MASK;
   pn = (offset >> GUPCR_VM_OFFSET_BITS) & GUPCR_VM_PAGE_MASK;
   this_page = (pn << GUPCR_THREAD_SIZE) | GUPCR_PTS_THREAD (p);
-  if (this_page == __upc_page1_ref)
-    addr = (char *) __upc_page1_base + p_offset;
-  else if (this_page == __upc_page2_ref)
-    addr = (char *) __upc_page2_base + p_offset;
+  if (this_page == tld->page1_ref)
+    addr = (char *) tld->page1_base + p_offset;
+  else if (this_page == tld->page2_ref)
+    addr = (char *) tld->page2_base + p_offset;
   else
     addr = __upc_vm_map_addr (p);
   return addr;
 }
 
+#endif /* GUPCR_USE_PTHREADS */
+
 #ifdef __UPC__
   typedef upc_shared_ptr_t
           __attribute__((__may_alias__)) upc_shared_ptr_alias_t;
@@ -141,6 +141,82 @@ extern int __upc_num_cpus;
 	    } \
 	} \
     }
+
+/* Give a hint to the cpu that this is a spin-wait loop.  */
+#if defined (__x86_64__) || defined (i386)
+#define __upc_cpu_relax() asm __volatile__ ("pause":::"memory")
+#elif defined (__aarch64__)
+#define __upc_cpu_relax() asm __volatile__ ("yield":::"memory")
+#else
+#define __upc_cpu_relax() asm __volatile__ ("":::"memory")
+#endif
+
+/* Number of iterations to spin, waiting for a flag to change,
+   before the waiting thread blocks.  Calibrated at startup.  */
+extern int __upc_spin_wait_count;
+
+extern void __upc_futex_wait (int *, int);
+extern void __upc_futex_wake (int *);
+
+/* Wait until PREDICATE is true.  PREDICATE depends upon the value
+   of the integer pointed to by FLAG, which is changed by the thread
+   that releases the waiter.  PARKED points to an integer, written
+   only by the waiting thread, that tells the releasing thread
+   whether the waiter may be blocked.
+
+   Spin for __upc_spin_wait_count iterations; then block on FLAG.
+   The waiter announces that it is about to block before
+   re-checking PREDICATE, and the releaser changes FLAG before it
+   checks PARKED, so either the waiter sees the new value of FLAG,
+   or the releaser sees PARKED set and wakes the waiter.  If FLAG
+   changes after it was read by the waiter, the futex wait returns
+   immediately.  */
+#define __upc_spin_wait_until(PREDICATE, FLAG, PARKED) \
+    { \
+      int i = 0; \
+      while (!(PREDICATE)) \
+	{ \
+	  if (++i < __upc_spin_wait_count) \
+	    __upc_cpu_relax (); \
+	  else \
+	    { \
+	      int flag_val = *(volatile int *) (FLAG); \
+	      *(volatile int *) (PARKED) = 1; \
+	      __sync_synchronize (); \
+	      if (!(PREDICATE)) \
+		__upc_futex_wait ((int *) (FLAG), flag_val); \
+	      *(volatile int *) (PARKED) = 0; \
+	      i = 0; \
+	    } \
+	} \
+    }
+
+/* Wake the thread waiting for FLAG to change, if it is blocked.
+   This must be called after FLAG has been changed.  */
+#define __upc_spin_wait_release(FLAG, PARKED) \
+    { \
+      __sync_synchronize (); \
+      if (*(volatile int *) (PARKED)) \
+	__upc_futex_wake ((int *) (FLAG)); \
+    }
 //end lib_spin_until
 
+/* Environment variables. */
+/** Number of microseconds that a thread waiting in a barrier
+    or for a lock spins before it blocks.  */
+#define GUPCR_SPIN_WAIT_ENV "UPC_SPIN_WAIT"
+
+/* Default spin-wait interval (microseconds), used if there are
+   at least as many cpus as UPC threads.  */
+#define GUPCR_SPIN_WAIT_DEFAULT 100
+
+/* Default spin-wait interval (microseconds), used if there are more
+   UPC threads than cpus.  Waiting threads then block almost at once,
+   giving their cpu to the threads that they are waiting for.  */
+#define GUPCR_SPIN_WAIT_OVERSUBSCRIBED 2
+
+/* Number of iterations of the spin-wait loop that are timed
+   when the spin-wait count is calibrated.  */
+#define GUPCR_SPIN_WAIT_CALIBRATE_COUNT 1000
+
 #endif /* _UPC_SYNC_H_ */
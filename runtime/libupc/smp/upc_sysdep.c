@@ -13,6 +13,11 @@
 #include "upc_defs.h"
 #include "upc_sup.h"
 #include "upc_sync.h"
+#include "upc_lib.h"
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
 
 #ifdef __sgi__
 #ifndef _SC_NPROCESSORS_ONLN
@@ -35,6 +40,100 @@ __upc_sys_init ()
     }
 }
 
+/* Number of iterations of the spin-wait loop executed by
+   a thread waiting in a barrier or for a lock, before it blocks.  */
+int __upc_spin_wait_count;
+
+/* Convert the spin-wait interval, in microseconds, given by the
+   UPC_SPIN_WAIT environment variable (or the default interval)
+   into an iteration count for __upc_spin_wait_until, by timing
+   a short spin-wait loop.  Called after THREADS is known.  */
+
+void
+__upc_spin_wait_init (void)
+{
+  const char *spin_wait_env = getenv (GUPCR_SPIN_WAIT_ENV);
+  long usecs, count;
+  upc_tick_t start;
+  uint64_t ns;
+  int i;
+  if (spin_wait_env)
+    {
+      char *end;
+      usecs = strtol (spin_wait_env, &end, 10);
+      if (end == spin_wait_env || *end || usecs < 0)
+	{
+	  fprintf (stderr, "UPC error: invalid %s value: %s\n",
+		   GUPCR_SPIN_WAIT_ENV, spin_wait_env);
+	  exit (2);
+	}
+    }
+  else if (__upc_num_cpus <= 1)
+    usecs = 0;
+  else if (THREADS > __upc_num_cpus)
+    usecs = GUPCR_SPIN_WAIT_OVERSUBSCRIBED;
+  else
+    usecs = GUPCR_SPIN_WAIT_DEFAULT;
+  start = upc_ticks_now ();
+  for (i = 0; i < GUPCR_SPIN_WAIT_CALIBRATE_COUNT; ++i)
+    __upc_cpu_relax ();
+  ns = upc_ticks_to_ns (upc_ticks_now () - start);
+  if (!ns)
+    ns = 1;
+  count = (long) ((double) usecs * 1000.0
+		  * GUPCR_SPIN_WAIT_CALIBRATE_COUNT / (double) ns);
+  __upc_spin_wait_count = (count > __INT_MAX__) ? __INT_MAX__ : (int) count;
+}
+
+#ifdef __linux__
+
+/* Block until *ADDR is no longer equal to VAL, or until the thread
+   is woken by __upc_futex_wake.  The futex is not process-private,
+   because in the process model the UPC threads map the same shared
+   memory at different addresses.  */
+
+void
+__upc_futex_wait (int *addr, int val)
+{
+  if (syscall (SYS_futex, addr, FUTEX_WAIT, val, NULL, NULL, 0) < 0
+      && errno != EAGAIN && errno != EINTR)
+    {
+      perror ("UPC futex wait");
+      abort ();
+    }
+}
+
+/* Wake all threads blocked on ADDR.  */
+
+void
+__upc_futex_wake (int *addr)
+{
+  if (syscall (SYS_futex, addr, FUTEX_WAKE, __INT_MAX__, NULL, NULL, 0) < 0)
+    {
+      perror ("UPC futex wake");
+      abort ();
+    }
+}
+
+#else /* !__linux__ */
+
+/* Without futexes, a blocked waiter gives up the cpu and
+   polls its flag again.  */
+
+void
+__upc_futex_wait (int *addr, int val)
+{
+  if (*(volatile int *) addr == val)
+    __upc_yield_cpu ();
+}
+
+void
+__upc_futex_wake (int *addr __attribute__ ((unused)))
+{
+}
+
+#endif /* __linux__ */
+
 char *__upc_strsignal (sig)
      int sig;
 {
@@ -44,6 +44,7 @@ typedef os_atomic_t os_lock_t;
 typedef os_lock_t *os_lock_p;
 
 extern void __upc_sys_init (void);
+extern void __upc_spin_wait_init (void);
 
 extern int __upc_atomic_get_bit (os_atomic_p, int);
 extern void __upc_atomic_set_bit (os_atomic_p, int);
@@ -15,6 +15,16 @@
 #include "upc_sync.h"
 #include "upc_numa.h"
 
+/* Per-thread runtime state, used by both runtime models.  In the
+   process model, the last two unique (page, thread) lookups are
+   also cached in it.  See __upc_sptr_to_addr() in upc_sup.h.
+   NOTE: for this to work correctly GUPCR_VM_GLOBAL_SET_SIZE
+   must be >=2, otherwise a cached mapped entry might be
+   swapped out.  */
+GUPCR_THREAD_LOCAL upc_tld_t __upc_tld;
+
+#ifndef GUPCR_USE_PTHREADS
+
 /* There is a local page table for each thread. The
    local page table maps a local page to the location
    where it has been mapped into the thread's memory.  */
@@ -22,14 +32,6 @@ typedef void *upc_lpte_t;
 typedef upc_lpte_t *upc_lpte_p;
 GUPCR_THREAD_LOCAL upc_lpte_p __upc_lpt;
 
-/* To speed things up, the last two unique (page, thread)
-   lookups are cached.  See __upc_sptr_to_addr() in upc_sup.h. 
-   NOTE: for this to work correctly GUPCR_VM_GLOBAL_SET_SIZE
-   must be >=2, otherwise a cached mapped entry might be
-   swapped out.  */
-GUPCR_THREAD_LOCAL unsigned long __upc_page1_ref, __upc_page2_ref;
-GUPCR_THREAD_LOCAL void *__upc_page1_base, *__upc_page2_base;
-
 /* Each thread maintains a series of mapped regions
    of memory that are mapped to specific global pages.
    The Global Map Table (gmt) is indexed by a hashed
@@ -50,12 +52,16 @@ typedef upc_gme_set_t upc_global_map_t[GUPCR_VM_GLOBAL_MAP_SIZE];
 typedef upc_global_map_t *upc_global_map_p;
 static GUPCR_THREAD_LOCAL upc_global_map_p __upc_gmt;
 
+#endif /* !GUPCR_USE_PTHREADS */
+
 /* Record the current value of the number of pages allocated.
    This value is updated to the global value in the UPC info.
    structure whenever an attempt is made to access a page
    whose page number is not less than this current value.  */
 GUPCR_THREAD_LOCAL upc_page_num_t __upc_cur_page_alloc;
 
+#ifndef GUPCR_USE_PTHREADS
+
 /* If this thread's idea of how many pages have been allocated
    per thread is less than the actual value stored in the
    UPC information structure, map the additional pages allocated
@@ -120,9 +126,6 @@ __upc_vm_get_cur_page_alloc ()
 		  perror ("UPC runtime error: can't map local region");
 		  abort ();
 	        }
-              /* set affinity to this region */
-	      __upc_numa_memory_region_affinity_set (u, MYTHREAD, region_base,
-                                                       region_size * GUPCR_VM_PAGE_SIZE);
 	      /* Update the local page table */
 	      for (j = 0; j < region_size; ++j)
 	        {
@@ -246,13 +249,75 @@ __upc_vm_init_per_thread ()
         g->local_page = (void *)0;
       }
   /* Invalidate the page lookup cache keys */
-  __upc_page1_ref = GUPCR_VM_PAGE_INVALID;
-  __upc_page2_ref = GUPCR_VM_PAGE_INVALID;
+  __upc_tld.page1_ref = GUPCR_VM_PAGE_INVALID;
+  __upc_tld.page2_ref = GUPCR_VM_PAGE_INVALID;
   /* Update Local Page Table to reflect initial allocation.  */
   __upc_cur_page_alloc = 0;
   (void) __upc_vm_get_cur_page_alloc ();
 }
 
+/* Place the ALLOC_PAGES pages per thread that were just added
+   (starting at per-thread page PAGE_ALLOC) on the NUMA node of
+   the thread that they have affinity to.  This is done when the
+   pages are allocated, rather than when each thread maps its own
+   pages, so that the placement does not depend on which thread
+   first touches a page (for example, the thread that extends
+   the heap).  The new pages of each thread are contiguous in
+   the global memory file; temporarily map all of them.  */
+
+static void
+__upc_vm_place_pages (const upc_info_p u, upc_page_num_t page_alloc,
+		      upc_page_num_t alloc_pages)
+{
+  const size_t thread_size = (size_t) alloc_pages * GUPCR_VM_PAGE_SIZE;
+  const off_t offset = ((off_t) (page_alloc * THREADS))
+		       << GUPCR_VM_OFFSET_BITS;
+  char *region_base;
+  int t;
+  if ((u->sched_policy == GUPCR_SCHED_POLICY_AUTO)
+      || (u->mem_policy == GUPCR_MEM_POLICY_AUTO))
+    return;
+  region_base = mmap ((void *) 0, thread_size * THREADS,
+		      PROT_READ | PROT_WRITE, MAP_SHARED,
+		      u->smem_fd, offset);
+  if (region_base == MAP_ERROR)
+    {
+      perror ("UPC runtime error: can't map new global pages");
+      abort ();
+    }
+  for (t = 0; t < THREADS; ++t)
+    __upc_numa_memory_region_affinity_set (u, t,
+					   region_base + t * thread_size,
+					   thread_size);
+  if (munmap (region_base, thread_size * THREADS))
+    {
+      perror ("UPC runtime error: can't unmap new global pages");
+      abort ();
+    }
+}
+
+/* Touch each page initially allocated to this thread, so that
+   the pages are faulted in (on this thread's node, if a memory
+   policy is in effect) during start up, rather than by the first
+   references made by the program.  All threads do this in
+   parallel, before the start up barrier.  A read is sufficient
+   to allocate a page of the global memory file, and it does not
+   interfere with concurrent initialization of shared data.  */
+
+void
+__upc_vm_pretouch_per_thread ()
+{
+  const size_t os_page_size = getpagesize ();
+  upc_page_num_t p;
+  for (p = 0; p < __upc_cur_page_alloc; ++p)
+    {
+      const char *page = (const char *) __upc_lpt[p];
+      size_t offset;
+      for (offset = 0; offset < GUPCR_VM_PAGE_SIZE; offset += os_page_size)
+	(void) *(volatile const char *) (page + offset);
+    }
+}
+
 /* Expand the shared memory file to hold an additional
    'alloc_pages' per thread.  Update the '__upc_cur_page_alloc'
    field in the UPC info. block to reflect the size increase.  */
@@ -293,6 +358,7 @@ __upc_vm_alloc (upc_page_num_t alloc_pages)
 	  u->gpt[pt] = (page_alloc * THREADS) + (alloc_pages * t) + i;
 	}
     }
+  __upc_vm_place_pages (u, page_alloc, alloc_pages);
   GUPCR_WRITE_FENCE ();
   u->cur_page_alloc = new_page_alloc;
   GUPCR_FENCE ();
@@ -334,14 +400,181 @@ __upc_vm_map_remote_offset (int t, size_t offset)
       page_base = __upc_vm_map_global_page (t, pn);
     }
   /* Update the cached lookup entries. */
-  __upc_page2_ref = __upc_page1_ref;
-  __upc_page2_base = __upc_page1_base;
-  __upc_page1_ref = (pn << GUPCR_THREAD_SIZE) | t;
-  __upc_page1_base = page_base;
+  __upc_tld.page2_ref = __upc_tld.page1_ref;
+  __upc_tld.page2_base = __upc_tld.page1_base;
+  __upc_tld.page1_ref = (pn << GUPCR_THREAD_SIZE) | t;
+  __upc_tld.page1_base = page_base;
   addr = (char *)page_base + p_offset;
   return addr;
 }
 
+#else /* GUPCR_USE_PTHREADS */
+
+/* In the POSIX threads model, all UPC threads share one address
+   space.  The shared memory of all threads is a single anonymous
+   region, reserved at start up, where thread T's memory begins
+   at T * __upc_vm_thread_stride.  Converting a shared address to
+   a local address is then simple arithmetic (see
+   __upc_sptr_to_addr() in upc_sup.h): there is no global memory
+   file, no page tables, and no map caches.  Pages are made
+   accessible as they are allocated.  These variables are shared
+   by all threads; they are set before the threads are created.  */
+char *__upc_vm_base;
+size_t __upc_vm_thread_stride;
+
+/* Maximum number of pages per thread that fit within the stride.  */
+static upc_page_num_t __upc_vm_max_pages_per_thread;
+
+/* Reserve the address space for the shared memory of all threads.
+   Prefer the largest per-thread stride permitted by the shared
+   pointer representation, and use a smaller stride if the address
+   space cannot accommodate THREADS regions of that size.  The
+   reservation is not backed by memory until pages are allocated.  */
+
+static void
+__upc_vm_reserve (upc_page_num_t num_init_local_pages)
+{
+  const size_t min_stride = (size_t) num_init_local_pages
+			    * GUPCR_VM_PAGE_SIZE;
+  size_t stride = (size_t) GUPCR_VM_MAX_PAGES_PER_THREAD
+		  * GUPCR_VM_PAGE_SIZE;
+  void *base = MAP_ERROR;
+  while (stride >= min_stride && stride >= GUPCR_VM_PAGE_SIZE)
+    {
+      base = mmap ((void *) 0, stride * THREADS, PROT_NONE,
+		   MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+		   -1, OFFSET_ZERO);
+      if (base != MAP_ERROR)
+	break;
+      stride >>= 1;
+    }
+  if (base == MAP_ERROR)
+    {
+      perror ("UPC runtime error: can't reserve shared memory");
+      abort ();
+    }
+  __upc_vm_base = (char *) base;
+  __upc_vm_thread_stride = stride;
+  __upc_vm_max_pages_per_thread = stride / GUPCR_VM_PAGE_SIZE;
+}
+
+/* Return the current number of pages allocated per thread.  */
+
+upc_page_num_t
+__upc_vm_get_cur_page_alloc ()
+{
+  const upc_info_p u = __upc_info;
+  if (!u)
+    __upc_fatal ("UPC runtime not initialized");
+  __upc_acquire_lock (&u->lock);
+  GUPCR_FENCE ();
+  __upc_cur_page_alloc = u->cur_page_alloc;
+  GUPCR_READ_FENCE ();
+  __upc_release_lock (&u->lock);
+  return __upc_cur_page_alloc;
+}
+
+/* Initialize the VM system.  Reserve the shared memory region
+   and initially allocate 'num_init_local_pages' per UPC thread.  */
+
+void 
+__upc_vm_init (upc_page_num_t num_init_local_pages)
+{
+  __upc_vm_reserve (num_init_local_pages);
+  if (!__upc_vm_alloc (num_init_local_pages))
+    { perror ("UPC runtime error: can't allocate global memory"); abort (); }
+}
+
+/* Per thread VM initialization.  */
+
+void
+__upc_vm_init_per_thread ()
+{
+  __upc_cur_page_alloc = 0;
+  (void) __upc_vm_get_cur_page_alloc ();
+}
+
+/* Touch each page initially allocated to this thread, so that
+   the pages are faulted in during start up, in parallel and
+   on this thread's node, rather than by the first references
+   made by the program.  */
+
+void
+__upc_vm_pretouch_per_thread ()
+{
+  const size_t os_page_size = getpagesize ();
+  char *base = __upc_vm_base + MYTHREAD * __upc_vm_thread_stride;
+  const size_t size = (size_t) __upc_cur_page_alloc * GUPCR_VM_PAGE_SIZE;
+  size_t offset;
+  /* A read of private anonymous memory only maps the zero page,
+     so write to each page.  Thread 0 may be initializing shared
+     data concurrently, so the write is an atomic add of zero,
+     which leaves the contents unchanged.  */
+  for (offset = 0; offset < size; offset += os_page_size)
+    (void) __upc_sync_fetch_and_add ((int *) (base + offset), 0);
+}
+
+/* Make an additional 'alloc_pages' per thread accessible, placing
+   them on the NUMA node of the thread they have affinity to.
+   Update the '__upc_cur_page_alloc' field in the UPC info. block
+   to reflect the size increase.  */
+
+int
+__upc_vm_alloc (upc_page_num_t alloc_pages)
+{
+  const upc_info_p u = __upc_info;
+  const size_t region_size = (size_t) alloc_pages * GUPCR_VM_PAGE_SIZE;
+  upc_page_num_t page_alloc;
+  upc_page_num_t new_page_alloc;
+  int t;
+  if (!u)
+    __upc_fatal ("UPC runtime not initialized");
+  __upc_acquire_lock (&u->lock);
+  GUPCR_FENCE ();
+  page_alloc = u->cur_page_alloc;
+  GUPCR_READ_FENCE ();
+  new_page_alloc = page_alloc + alloc_pages;
+  if (new_page_alloc > __upc_vm_max_pages_per_thread)
+    {
+      __upc_release_lock (&u->lock);
+      return 0;
+    }
+  for (t = 0; t < THREADS; ++t)
+    {
+      char *region_base = __upc_vm_base + t * __upc_vm_thread_stride
+			  + (size_t) page_alloc * GUPCR_VM_PAGE_SIZE;
+      if (mprotect (region_base, region_size, PROT_READ | PROT_WRITE))
+	{
+	  __upc_release_lock (&u->lock);
+	  return 0;
+	}
+      __upc_numa_memory_region_affinity_set (u, t, region_base, region_size);
+    }
+  GUPCR_WRITE_FENCE ();
+  u->cur_page_alloc = new_page_alloc;
+  GUPCR_FENCE ();
+  __upc_release_lock (&u->lock);
+  return 1;
+}
+
+/* Convert a shared offset within thread T's memory into
+   an address mapped in the current thread's address space.  */
+
+void *
+__upc_vm_map_remote_offset (int t, size_t offset)
+{
+  const upc_page_num_t pn = offset >> GUPCR_VM_OFFSET_BITS;
+  if (pn >= __upc_cur_page_alloc)
+    {
+      __upc_cur_page_alloc = __upc_vm_get_cur_page_alloc ();
+      if (pn >= __upc_cur_page_alloc)
+        __upc_fatal ("Virtual address in shared address is out of range");
+    }
+  return __upc_vm_base + t * __upc_vm_thread_stride + offset;
+}
+
+#endif /* !GUPCR_USE_PTHREADS */
+
 void *
 __upc_vm_map_addr (upc_shared_ptr_t p)
 {
@@ -0,0 +1,80 @@
+#!/usr/bin/perl
+#
+# usage:
+#
+# $PERL gen-upcbench-atomic.pl upc_types.def upc_ops.def >
+#                              upcbench_atomic.def
+#
+# This script reads the autogen definition files that describe
+# the UPC types and operations, and writes one
+#
+#   UPCBENCH_ATOMIC_TYPE (NAME, ABBREV, NUMERIC_OK, BIT_OK)
+#
+# line for each type that has the 'type_atomic_ok' attribute and one
+#
+#   UPCBENCH_ATOMIC_OP (NAME, OP_NAME, MODE, OPERAND1, OPERAND2)
+#
+# line for each operation that has the 'op_atomic_ok' attribute.
+# MODE is one of UPCBENCH_OP_ACCESS, UPCBENCH_OP_NUMERIC or
+# UPCBENCH_OP_LOGICAL; OPERAND1 and OPERAND2 are 1 if the operation
+# requires that operand, and 0 if it must be passed as NULL.
+# The atomics benchmark includes the output after defining the
+# two macros, so that it always covers every atomic type and
+# operation supported by the runtime.
+#
+use strict;
+use warnings;
+
+die "usage: $0 upc_types.def upc_ops.def\n" unless @ARGV == 2;
+my ($types_def, $ops_def) = @ARGV;
+
+# Return the list of 'KIND = { ... };' records in FILE, each
+# as a reference to a hash of its attributes.
+sub read_records
+{
+  my ($file, $kind) = @_;
+  open (my $fh, '<', $file) or die "$file: $!\n";
+  my $text = do { local $/; <$fh> };
+  close ($fh);
+  $text =~ s{/\*.*?\*/}{}gs;
+  my @records;
+  while ($text =~ /\b$kind\s*=\s*\{(.*?)\};/gs)
+    {
+      my %attr;
+      for my $item (split /;/, $1)
+        {
+	  if ($item =~ /^\s*(\w+)\s*=\s*"?([^"]*?)"?\s*$/s)
+	    {
+	      $attr{$1} = $2;
+	    }
+	  elsif ($item =~ /^\s*(\w+)\s*$/)
+	    {
+	      $attr{$1} = 1;
+	    }
+	}
+      push @records, \%attr;
+    }
+  die "$file: no '$kind' definitions found\n" unless @records;
+  return @records;
+}
+
+print "/* Generated by gen-upcbench-atomic.pl from upc_types.def"
+      . " and upc_ops.def.  */\n\n";
+
+for my $type (read_records ($types_def, 'upc_type'))
+  {
+    next unless $type->{type_atomic_ok};
+    printf "UPCBENCH_ATOMIC_TYPE (%s, \"%s\", %d, %d)\n",
+	   $type->{type_upc_name}, $type->{type_abbrev},
+	   $type->{type_numeric_op_ok} ? 1 : 0,
+	   $type->{type_bit_op_ok} ? 1 : 0;
+  }
+print "\n";
+for my $op (read_records ($ops_def, 'upc_op'))
+  {
+    next unless $op->{op_atomic_ok};
+    printf "UPCBENCH_ATOMIC_OP (%s, \"%s\", UPCBENCH_OP_%s, %d, %d)\n",
+	   $op->{op_upc_name}, $op->{op_name}, uc ($op->{op_mode}),
+	   $op->{op_require_operand1} ? 1 : 0,
+	   $op->{op_require_operand2} ? 1 : 0;
+  }
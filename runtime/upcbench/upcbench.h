@@ -0,0 +1,107 @@
+/*===-- upcbench.h - UPC Runtime Microbenchmarks -------------------------===
+|*
+|*                     The LLVM Compiler Infrastructure
+|*
+|* Copyright 2012-2014, Intrepid Technology, Inc.  All rights reserved.
+|* This file is distributed under a BSD-style Open Source License.
+|* See LICENSE-INTREPID.TXT for details.
+|*
+|*===---------------------------------------------------------------------===*/
+
+#ifndef _UPCBENCH_H_
+#define _UPCBENCH_H_
+
+/* UPC runtime microbenchmarks.
+
+   Each benchmark is timed by every participating thread; the
+   results are reported by thread 0 as one CSV line, with the
+   fields listed in UPCBENCH_CSV_HEADER:
+
+     suite	   benchmark group (access, mem, sync, lock, atomic, coll)
+     benchmark	   operation measured
+     variant	   operation variant (for example, the atomic type)
+     peer	   local, node, remote, or all
+     threads	   number of UPC threads in the run
+     active	   number of threads that performed the operation
+     size	   bytes transferred by one operation (0 if none)
+     iterations	   operations performed by each active thread
+     time_ns	   elapsed time of the slowest active thread
+     latency_ns	   time_ns / iterations
+     bandwidth_mbs aggregate bandwidth, in MB/s (0 if size is 0)
+
+   Lines that begin with '#' are comments that describe the run.  */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Environment variable that, if set, adds a 'tag' to the run
+   description (for example, a release or commit identifier).  */
+#define UPCBENCH_TAG_ENV "UPCBENCH_TAG"
+
+#define UPCBENCH_CSV_HEADER \
+  "suite,benchmark,variant,peer,threads,active,size,iterations," \
+  "time_ns,latency_ns,bandwidth_mbs"
+
+/* Default message size range, in bytes.  */
+#define UPCBENCH_MIN_SIZE_DEFAULT 8
+#define UPCBENCH_MAX_SIZE_DEFAULT (1 << 20)
+
+/* Default number of iterations used for small operations.  */
+#define UPCBENCH_ITERS_DEFAULT 10000
+
+/* The number of iterations is reduced for large messages,
+   so that each measurement moves about this many bytes.  */
+#define UPCBENCH_BYTES_PER_TEST (64 << 20)
+
+/* Number of non-blocking operations kept in flight by
+   the pipelined non-blocking transfer benchmarks.  */
+#define UPCBENCH_NB_WINDOW 16
+
+/* The thread that a point-to-point benchmark communicates with.  */
+typedef enum
+  {
+    UPCBENCH_PEER_LOCAL,
+    UPCBENCH_PEER_NODE,
+    UPCBENCH_PEER_REMOTE,
+    UPCBENCH_PEER_ALL
+  } upcbench_peer_t;
+#define UPCBENCH_NUM_PEERS 3
+
+/* Command line options.  */
+typedef struct upcbench_opts_struct
+  {
+    size_t min_size;
+    size_t max_size;
+    long iters;
+    int csv_header;
+    const char *suites;
+  } upcbench_opts_t;
+
+extern upcbench_opts_t upcbench_opts;
+
+/* Sink for values read by the benchmarks, so that the
+   reads are not optimized away.  */
+extern volatile long upcbench_sink;
+
+extern uint64_t upcbench_now (void);
+extern long upcbench_iters (size_t);
+extern int upcbench_peer_thread (upcbench_peer_t);
+extern const char *upcbench_peer_name (upcbench_peer_t);
+extern void upcbench_report (const char *, const char *, const char *,
+			     upcbench_peer_t, size_t, long, int, uint64_t);
+
+/* Iterate SIZE over the powers of 2 in the selected
+   message size range.  */
+#define UPCBENCH_FOR_EACH_SIZE(SIZE) \
+  for ((SIZE) = upcbench_opts.min_size; \
+       (SIZE) <= upcbench_opts.max_size; (SIZE) *= 2)
+
+/* Benchmark suites.  Each is a collective operation.  */
+extern void upcbench_access (void);
+extern void upcbench_mem (void);
+extern void upcbench_sync (void);
+extern void upcbench_lock (void);
+extern void upcbench_atomic (void);
+extern void upcbench_coll (void);
+
+#endif /* !_UPCBENCH_H_ */
@@ -0,0 +1,57 @@
+// RUN: %clang_analyze_cc1 -x upc -verify %s \
+// RUN:   -analyzer-checker=optin.performance.upc
+
+typedef __SIZE_TYPE__ size_t;
+void upc_memget(void *, shared const void *, size_t);
+
+shared int a[100 * THREADS];
+shared [10] int b[100 * THREADS];
+shared int s;
+strict shared int flag;
+
+int remote_in_loop(int n) {
+  int i, sum = 0;
+  for (i = 0; i < n; ++i)
+    sum += a[i]; // expected-warning{{Each iteration accesses shared 'a[i]' with a separate, possibly remote, communication operation}}
+  for (i = 0; i < n; ++i)
+    sum += s + s; // expected-warning{{Each iteration accesses shared 's'}}
+  for (i = 0; i < n; ++i)
+    sum += a[MYTHREAD];
+  upc_forall (i = 0; i < n; ++i; &a[i])
+    sum += a[i];
+  upc_forall (i = 0; i < n; ++i; i)
+    sum += a[i];
+  return sum;
+}
+
+void forall_affinity(int n) {
+  int i;
+  upc_forall (i = 0; i < n; ++i; i) // expected-warning{{The affinity expression 'i' of this upc_forall does not match any shared access in the loop body, so the accesses are remote; use '&b[i]' as the affinity expression}}
+    b[i] = 0; // expected-warning{{Each iteration accesses shared 'b[i]'}}
+  upc_forall (i = 0; i < n; ++i; &b[i])
+    b[i] = 0;
+}
+
+void strict_in_loop(int n) {
+  int i;
+  while (flag == 0)
+    ;
+  for (i = 0; i < n; ++i)
+    flag = i; // expected-warning{{Each iteration performs a strict access to 'flag'}}
+}
+
+void transfer_in_loop(int *dst, int n) {
+  int i;
+  for (i = 0; i < n; ++i)
+    upc_memget(dst + i * 10, &b[i * 10 * THREADS], 10 * sizeof(int)); // expected-warning{{'upc_memget' is called once per iteration with addresses that depend on the loop variable}}
+  for (i = 0; i < n; ++i)
+    upc_memget(dst, &b[0], sizeof(int));
+}
+
+int privatizable_pointer(shared [] int *p, int n) {
+  int i, sum = 0;
+  for (i = 0; i < n; ++i)
+    sum += p[i]; // expected-warning{{Each iteration accesses shared 'p[i]'}}
+  // expected-warning@-1{{Pointer-to-shared arithmetic on 'p' in a loop; all the data it points to is on one thread, so if 'upc_threadof(p) == MYTHREAD', cast it to a private pointer before the loop}}
+  return sum;
+}
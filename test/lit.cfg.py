@@ -93,6 +93,14 @@ if config.has_plugins and config.llvm_plugin_ext:
 if config.clang_default_cxx_stdlib != '':
     config.available_features.add('default-cxx-stdlib-set')
 
+# The UPC runtime model the driver links against.
+if config.libupc_runtime_model == 'smp':
+    config.available_features.add('upc-smp')
+
+# The UPC runtime bitcode libraries linked under -flto.
+if config.libupc_enable_lto_lib:
+    config.available_features.add('upc-lto-lib')
+
 # As of 2011.08, crash-recovery tests still do not pass on FreeBSD.
 if platform.system() not in ['FreeBSD']:
     config.available_features.add('crash-recovery')